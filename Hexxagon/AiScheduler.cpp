@@ -0,0 +1,126 @@
+#include "AiScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include "Endgame.h"
+#include "Search.h"
+#include "Zobrist.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    AiScheduler::AiScheduler(const Options& options, std::function<void()> notify) :
+        options(options),
+        notify(std::move(notify))
+    {
+        if (!options.book_path.empty())
+            book.load(options.book_path);
+        for (int i = 0; i < std::max(1, options.workers); i++)
+            threads.emplace_back(&AiScheduler::run, this);
+    }
+
+    ////////////////////////////////////////////////////////////
+    AiScheduler::~AiScheduler()
+    {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    ////////////////////////////////////////////////////////////
+    int AiScheduler::getMoveTime(int budget_left, int empty_cells)
+    {
+        int queued;
+        {
+            std::lock_guard lock(mutex);
+            queued = (int)requests.size();
+        }
+
+        // own steps left are about half of the empty cells, each clone fills one
+        const int steps_left = std::max(4, empty_cells / 2);
+        int milliseconds = std::min(options.move_milliseconds, budget_left / steps_left);
+
+        // with more requests waiting than workers, every request gets a share of one worker round
+        const int workers = (int)threads.size();
+        if (queued > workers)
+            milliseconds = milliseconds * workers / queued;
+        return std::max(MinMoveMilliseconds, milliseconds);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void AiScheduler::submit(const Request& request)
+    {
+        {
+            std::lock_guard lock(mutex);
+            requests.push_back(request);
+        }
+        wake.notify_one();
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::vector<AiScheduler::Reply> AiScheduler::takeReplies()
+    {
+        std::lock_guard lock(mutex);
+        std::vector<Reply> taken;
+        taken.swap(replies);
+        return taken;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool AiScheduler::isSaturated()
+    {
+        std::lock_guard lock(mutex);
+        return (int)requests.size() >= options.queue_limit;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void AiScheduler::run()
+    {
+        Search search(options.table_megabytes);
+        EndgameSolver solver(options.table_megabytes);
+        std::unique_lock lock(mutex);
+        while (true) {
+            wake.wait(lock, [this] { return !requests.empty() || stopping; });
+            if (stopping)
+                return;
+            Request request = requests.front();
+            requests.pop_front();
+            lock.unlock();
+
+            const auto start = std::chrono::steady_clock::now();
+            const Difficulty& level = Difficulties[request.difficulty];
+            const Position& position = request.position;
+            const std::uint64_t seed = (std::uint64_t)request.game << 32 | request.generation;
+            std::optional<Move> move;
+
+            // book is built on the standard game board only
+            if (level.book && &position.getTopology() == &Topology::standard()) {
+                std::uint64_t random_state = seed ^ position.getHash();
+                move = book.probe(position, [&random_state](unsigned int bound) { return (unsigned int)(splitmix64(random_state) % bound); });
+            }
+
+            if (!move && level.endgame && position.getEmpty().count() <= EndgameSolver::EmptyThreshold) {
+                EndgameResult result = solver.solve(position, SolverNodes);
+                if (result.solved)
+                    move = result.move;
+            }
+
+            if (!move) {
+                SearchLimits limits = level.getLimits();
+                limits.milliseconds = std::min(limits.milliseconds, request.milliseconds);
+                search.setNoise(level.noise, seed);
+                move = search.run(position, limits).move;
+            }
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+            lock.lock();
+            replies.push_back({ request.game, request.generation, *move, (int)elapsed.count() });
+            lock.unlock();
+            notify();
+            lock.lock();
+        }
+    }
+}
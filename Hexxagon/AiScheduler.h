@@ -0,0 +1,100 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Difficulty.h"
+#include "OpeningBook.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    /// Pool of search threads shared by all computer players of
+    /// a server. Requests are served first come first served and
+    /// every game has at most one request queued, so games take
+    /// turns. Time of a step is cut when the queue grows, so the
+    /// pool keeps up with load instead of falling behind.
+    ///
+    /// Steps are chosen like HexxagonAI does: book moves and
+    /// solved endgames first, as the game's level allows, then
+    /// the search.
+    ////////////////////////////////////////////////////////////
+    class AiScheduler
+    {
+    public:
+        static constexpr int MinMoveMilliseconds = 5;       //!< step time under full load or with spent budget
+        static constexpr std::uint64_t SolverNodes = 1000000;       //!< solver gives up to the search after it
+
+        struct Options
+        {
+            int workers = 1;
+            int queue_limit = 256;      //!< queued requests, at which isSaturated() turns on
+            int move_milliseconds = 500;        //!< step time without load
+            int budget_milliseconds = 30000;        //!< search time of one game
+            int table_megabytes = 4;        //!< transposition table of each worker
+            int difficulty = DefaultDifficulty;     //!< of games, which don't ask for one
+            std::string book_path = "Assets\\book.bin";       //!< opening book of the standard board, no book if missing
+        };
+
+        struct Request
+        {
+            int game;
+            std::uint32_t generation;       //!< tells replies of reused game slots apart
+            Position position;
+            int milliseconds;
+            int difficulty;     //!< index into Difficulties, it's limits apply on top of 'milliseconds'
+        };
+
+        struct Reply
+        {
+            int game;
+            std::uint32_t generation;
+            Move move;
+            int milliseconds;       //!< time spent on the step
+        };
+
+    private:
+        Options options;
+        OpeningBook book;       //!< shared by the workers, read only after construction
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<Request> requests;
+        std::vector<Reply> replies;
+        bool stopping = false;
+        std::function<void()> notify;
+
+        std::vector<std::thread> threads;
+
+        void run();
+
+    public:
+        /// 'notify' is called from worker threads after every reply.
+        ///
+        AiScheduler(const Options& options, std::function<void()> notify);
+
+        AiScheduler(const AiScheduler&) = delete;
+        AiScheduler& operator=(const AiScheduler&) = delete;
+
+        ~AiScheduler();     //!< drops queued requests and waits for running ones
+
+        /// Returns search time for the next step of a game with
+        /// provided unspent budget: an even share of the budget
+        /// for expected rest of the game, shrunk by queue length.
+        ///
+        int getMoveTime(int budget_left, int empty_cells);
+
+        void submit(const Request& request);
+
+        std::vector<Reply> takeReplies();
+
+        bool isSaturated();     //!< returns 'true' if new games should be refused
+
+        const Options& getOptions() const { return options; }
+    };
+}
@@ -0,0 +1,91 @@
+#include "Analysis.h"
+#include "Evaluation.h"
+#include "Search.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    GameAnalysis::GameAnalysis(const Position& start, std::vector<Move> moves, int move_milliseconds, int thread_count) :
+        moves(std::move(moves)),
+        move_milliseconds(move_milliseconds)
+    {
+        positions.reserve(this->moves.size() + 1);
+        positions.push_back(start);
+        for (Move move : this->moves) {
+            positions.push_back(positions.back());
+            positions.back().make(move);
+        }
+        verdicts.resize(this->moves.size());
+        done = std::make_unique<std::atomic<bool>[]>(this->moves.size());
+
+        if (thread_count <= 0)
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        thread_count = std::min(thread_count, size());
+        for (int i = 0; i < thread_count; i++)
+            threads.emplace_back(&GameAnalysis::run, this);
+    }
+
+    ////////////////////////////////////////////////////////////
+    GameAnalysis::~GameAnalysis()
+    {
+        stopping = true;
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void GameAnalysis::run()
+    {
+        Search search(8);
+        SearchLimits limits;
+        limits.milliseconds = move_milliseconds;
+        limits.stop = &stopping;
+        for (int step = next++; step < size() && !stopping; step = next++) {
+            const Position& before = positions[step];
+            const Position& after = positions[step + 1];
+            Verdict& verdict = verdicts[step];
+
+            SearchResult best = search.run(before, limits);
+            if (best.depth < 2) {
+                SearchLimits shallow;       // the position after needs at least one ply
+                shallow.depth = 2;
+                shallow.stop = &stopping;
+                best = search.run(before, shallow);
+            }
+            verdict.best = best.move;
+            verdict.best_score = best.score;
+
+            int played_score;
+            if (after.isGameOver())
+                played_score = finalScore(after);
+            else {
+                SearchLimits reply;
+                reply.depth = best.depth - 1;
+                reply.stop = &stopping;
+                played_score = search.run(after, reply).score;
+            }
+            verdict.played_score = after.getSide() == before.getSide() ? played_score : -played_score;
+
+            done[step] = true;
+            completed++;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    AnalyzedStep GameAnalysis::get(int step) const
+    {
+        AnalyzedStep analyzed;
+        analyzed.played = moves[step];
+        analyzed.best = verdicts[step].best;
+        analyzed.side = positions[step].getSide();
+        analyzed.best_score = verdicts[step].best_score;
+        analyzed.played_score = verdicts[step].played_score;
+        analyzed.red_score = analyzed.side == Position::Red ? analyzed.played_score : -analyzed.played_score;
+
+        const int loss = analyzed.getLoss();
+        analyzed.mark = loss >= BlunderLoss ? AnalyzedStep::Blunder :
+            loss >= MistakeLoss ? AnalyzedStep::Mistake :
+            loss >= InaccuracyLoss ? AnalyzedStep::Inaccuracy : AnalyzedStep::Good;
+        return analyzed;
+    }
+}
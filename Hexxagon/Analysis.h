@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "Position.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    /// Verdict of the engine on one step of a recorded game.
+    /// Scores are for the side, which made the step.
+    ////////////////////////////////////////////////////////////
+    struct AnalyzedStep
+    {
+        enum Mark { Good, Inaccuracy, Mistake, Blunder };
+
+        Move played;
+        Move best;      //!< engine's choice in the same position
+        int side = Position::Red;
+        int best_score = 0;     //!< score of the position before the step, searched to some depth
+        int played_score = 0;       //!< score of the position after the step, searched one ply shallower
+        int red_score = 0;      //!< played_score from red's view, for the evaluation graph
+        Mark mark = Good;
+
+        int getLoss() const { return played == best ? 0 : std::max(0, best_score - played_score); }
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Analysis of a recorded game on background threads. Every
+    /// step is analysed once, by whichever thread takes it first,
+    /// in order from the start, so steps become ready about in
+    /// order while all cores work.
+    ///
+    /// The step is judged by the score of the position after it
+    /// against the score of the position before it. Evaluation
+    /// swings between odd and even depths, so the position before
+    /// is searched for the step's time and the position after to
+    /// exactly one ply less, as if the played move was searched
+    /// in the same tree.
+    ////////////////////////////////////////////////////////////
+    class GameAnalysis
+    {
+    public:
+        static constexpr int InaccuracyLoss = 100;      //!< lost score of one gamechip
+        static constexpr int MistakeLoss = 250;
+        static constexpr int BlunderLoss = 500;
+
+    private:
+        struct Verdict
+        {
+            Move best;
+            int best_score = 0;     //!< for the side, which made the step
+            int played_score = 0;
+        };
+
+        std::vector<Position> positions;        //!< position before every step and the final one
+        std::vector<Move> moves;
+        int move_milliseconds;
+
+        std::vector<Verdict> verdicts;      //!< one per step, written by it's thread before 'done'
+        std::unique_ptr<std::atomic<bool>[]> done;
+        std::atomic<int> next = 0;
+        std::atomic<int> completed = 0;
+        std::atomic<bool> stopping = false;
+        std::vector<std::thread> threads;
+
+        void run();
+
+    public:
+        /// Starts analysis of the moves played from 'start'.
+        /// Moves have to be legal. 0 threads take all cores.
+        ///
+        GameAnalysis(const Position& start, std::vector<Move> moves, int move_milliseconds, int thread_count = 0);
+
+        GameAnalysis(const GameAnalysis&) = delete;
+        GameAnalysis& operator=(const GameAnalysis&) = delete;
+
+        ~GameAnalysis();        //!< stops after current searches
+
+        int size() const { return (int)moves.size(); }      //!< returns count of steps
+
+        const Position& getPosition(int step) const { return positions[step]; }     //!< returns position before the step, size() - final one
+
+        bool isReady(int step) const { return done[step]; }
+
+        bool isFinished() const { return completed == size(); }
+
+        int getCompleted() const { return completed; }      //!< returns count of analysed steps, size() in total
+
+        /// Returns verdict on the step. The step has to be ready.
+        ///
+        AnalyzedStep get(int step) const;
+    };
+}
@@ -0,0 +1,104 @@
+#include "AssetRegistry.h"
+
+namespace sf
+{
+	AssetRegistry& AssetRegistry::instance() {
+		static AssetRegistry registry;
+		return registry;
+	}
+
+	const Font& AssetRegistry::font(const std::string& path) {
+		std::lock_guard<std::mutex> lock(mutex);
+		std::unique_ptr<Font>& font = fonts[path];
+		if (font == nullptr) {
+			font = std::make_unique<Font>();
+			if (!font->loadFromFile(path))
+				std::cout << "Font " << path << " could not load";
+		}
+		return *font;
+	}
+
+	const Texture& AssetRegistry::texture(const std::string& path) {
+		std::lock_guard<std::mutex> lock(mutex);
+		std::unique_ptr<Texture>& texture = textures[path];
+		if (texture == nullptr) {
+			texture = std::make_unique<Texture>();
+			if (!texture->loadFromFile(path))
+				std::cout << "Texture " << path << " could not load";
+		}
+		return *texture;
+	}
+
+	const Cursor& AssetRegistry::cursor(Cursor::Type type) {
+		std::lock_guard<std::mutex> lock(mutex);
+		std::unique_ptr<Cursor>& cursor = cursors[type];
+		if (cursor == nullptr) {
+			cursor = std::make_unique<Cursor>();
+			if (!cursor->loadFromSystem(type))
+				std::cout << "System cursor could not load";
+		}
+		return *cursor;
+	}
+
+	AtlasRegion AssetRegistry::region(const std::string& path) {
+		wait();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto iter = atlas_rects.find(path);
+			if (iter != atlas_rects.end())
+				return { &atlas, iter->second };
+		}
+		const Texture& standalone = texture(path);
+		return { &standalone, IntRect({ 0, 0 }, Vector2i(standalone.getSize())) };
+	}
+
+	void AssetRegistry::buildAtlas(const std::vector<std::string>& image_paths) {
+		const unsigned int max_width = 2048;
+		const unsigned int padding = 1;		// keeps filtering from bleeding into neighbour images
+
+		std::vector<Image> images(image_paths.size());
+		std::vector<IntRect> rects;
+		unsigned int x = 0, y = 0, shelf_height = 0, width = 0;
+		for (int i = 0; i < images.size(); i++) {
+			if (!images[i].loadFromFile(image_paths[i]))
+				std::cout << "Image " << image_paths[i] << " could not load";
+
+			Vector2u size = images[i].getSize();
+			if (x > 0 && x + size.x > max_width) {
+				x = 0;
+				y += shelf_height + padding;
+				shelf_height = 0;
+			}
+			rects.push_back(IntRect({ (int)x, (int)y }, Vector2i(size)));
+			x += size.x + padding;
+			shelf_height = std::max(shelf_height, size.y);
+			width = std::max(width, x);
+		}
+
+		Image packed;
+		packed.create({ std::max(width, 1u), std::max(y + shelf_height, 1u) }, Color::Transparent);
+		for (int i = 0; i < images.size(); i++)
+			packed.copy(images[i], Vector2u(rects[i].position));
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!atlas.loadFromImage(packed))
+			std::cout << "Atlas texture could not be created";
+		atlas_rects.clear();
+		for (int i = 0; i < image_paths.size(); i++)
+			atlas_rects[image_paths[i]] = rects[i];
+	}
+
+	void AssetRegistry::preload(std::vector<std::string> font_paths, std::vector<std::string> atlas_paths) {
+		wait();
+		preloading = std::async(std::launch::async, [this, font_paths, atlas_paths]() {
+			for (const std::string& path : font_paths)
+				font(path);
+			buildAtlas(atlas_paths);
+		});
+	}
+
+	void AssetRegistry::wait() {
+		if (preloading.valid())
+			preloading.wait();
+	}
+}
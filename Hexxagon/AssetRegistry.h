@@ -0,0 +1,73 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sf
+{
+	/// Part of a texture, in which one image is stored.
+	///
+	struct AtlasRegion {
+		const Texture* texture = nullptr;
+		IntRect rect;
+	};
+
+	/// Process-wide cache of fonts, textures and cursors.
+	/// Every asset is loaded from disk once and then
+	/// shared by reference between screens and widgets.
+	///
+	class AssetRegistry {
+	private:
+		std::mutex mutex;
+
+		std::map<std::string, std::unique_ptr<Font>> fonts;
+		std::map<std::string, std::unique_ptr<Texture>> textures;
+		std::map<Cursor::Type, std::unique_ptr<Cursor>> cursors;
+
+		Texture atlas;		//!< all images passed to buildAtlas(), packed in shelves
+		std::map<std::string, IntRect> atlas_rects;
+
+		std::future<void> preloading;		//!< background preloading started by preload()
+
+		AssetRegistry() {};
+
+	public:
+		AssetRegistry(const AssetRegistry&) = delete;
+		AssetRegistry& operator=(const AssetRegistry&) = delete;
+
+		static AssetRegistry& instance();
+
+		/// Getters, which load asset on first request.
+		///
+		const Font& font(const std::string& path);
+
+		const Texture& texture(const std::string& path);
+
+		const Cursor& cursor(Cursor::Type type);
+
+		/// Returns atlas region of the image. Images, which are
+		/// not packed into atlas, are loaded as separate textures.
+		///
+		AtlasRegion region(const std::string& path);
+
+		/// Packs provided images into single texture, so widgets
+		/// switch texture rects instead of textures.
+		///
+		void buildAtlas(const std::vector<std::string>& image_paths);
+
+		/// Starts loading of fonts and building of atlas on
+		/// background thread, so first screens don't wait for disk.
+		///
+		void preload(std::vector<std::string> font_paths, std::vector<std::string> atlas_paths);
+
+		/// Blocks until background preloading is finished.
+		///
+		void wait();
+	};
+}
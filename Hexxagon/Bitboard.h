@@ -0,0 +1,70 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+namespace Hexxagon
+{
+
+    ////////////////////////////////////////////////////////////
+    /// 128-bit set of game board cells. Bit index is the cell
+    /// index of a Topology, so boards up to radius 6 fit in.
+    ////////////////////////////////////////////////////////////
+    struct Bitboard
+    {
+        std::uint64_t lo = 0;
+        std::uint64_t hi = 0;
+
+        static constexpr int Capacity = 128;
+
+        constexpr Bitboard() = default;
+
+        constexpr Bitboard(std::uint64_t lo, std::uint64_t hi) : lo(lo), hi(hi) {}
+
+        static constexpr Bitboard cell(int index)      //!< returns set with single cell
+        {
+            return index < 64 ? Bitboard(std::uint64_t(1) << index, 0) : Bitboard(0, std::uint64_t(1) << (index - 64));
+        }
+
+        constexpr bool test(int index) const
+        {
+            return index < 64 ? (lo >> index) & 1 : (hi >> (index - 64)) & 1;
+        }
+
+        constexpr void set(int index) { *this |= cell(index); }
+
+        constexpr void reset(int index) { *this &= ~cell(index); }
+
+        constexpr bool empty() const { return (lo | hi) == 0; }
+
+        constexpr explicit operator bool() const { return !empty(); }
+
+        constexpr int count() const { return std::popcount(lo) + std::popcount(hi); }
+
+        constexpr int first() const     //!< returns index of the lowest cell, set must not be empty
+        {
+            return lo != 0 ? std::countr_zero(lo) : 64 + std::countr_zero(hi);
+        }
+
+        constexpr int popFirst()       //!< removes lowest cell from the set and returns it's index
+        {
+            int index = first();
+            if (lo != 0)
+                lo &= lo - 1;
+            else
+                hi &= hi - 1;
+            return index;
+        }
+
+        constexpr Bitboard operator&(const Bitboard& b) const { return { lo & b.lo, hi & b.hi }; }
+        constexpr Bitboard operator|(const Bitboard& b) const { return { lo | b.lo, hi | b.hi }; }
+        constexpr Bitboard operator^(const Bitboard& b) const { return { lo ^ b.lo, hi ^ b.hi }; }
+        constexpr Bitboard operator~() const { return { ~lo, ~hi }; }
+
+        constexpr Bitboard& operator&=(const Bitboard& b) { lo &= b.lo; hi &= b.hi; return *this; }
+        constexpr Bitboard& operator|=(const Bitboard& b) { lo |= b.lo; hi |= b.hi; return *this; }
+        constexpr Bitboard& operator^=(const Bitboard& b) { lo ^= b.lo; hi ^= b.hi; return *this; }
+
+        constexpr bool operator==(const Bitboard&) const = default;
+    };
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "Search.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    /// Strength of the computer player as search constraints.
+    /// Weak levels search few nodes and see a noisy evaluation,
+    /// so they are also cheap: a medium step costs about a
+    /// thousand nodes, a hard one several hundred thousands.
+    ////////////////////////////////////////////////////////////
+    struct Difficulty
+    {
+        const char* name;
+        int depth;      //!< iterations cap
+        std::uint64_t nodes;        //!< 0 - no limit
+        int milliseconds;
+        int noise;      //!< evaluation error amplitude, 100 - one gamechip
+        bool book;      //!< plays opening book moves
+        bool endgame;       //!< plays endgame solver's steps
+
+        SearchLimits getLimits() const
+        {
+            SearchLimits limits;
+            limits.depth = depth;
+            limits.nodes = nodes;
+            limits.milliseconds = milliseconds;
+            return limits;
+        }
+    };
+
+    /// Measured in engine matches from 4 random plies, default
+    /// evaluation weights, without book and endgame solver:
+    /// beginner scores 31% against easy and easy 22% against
+    /// medium (40 games each), medium 0% against hard and hard
+    /// 45% against expert (20 games each). Steps cost on average
+    /// about 200 nodes at beginner and easy, 1200 at medium and
+    /// 500000 at hard. Medium's node limit ends its depth 3
+    /// iteration early in crowded positions, a full one made
+    /// easy lose every game.
+    ///
+    inline constexpr std::array<Difficulty, 5> Difficulties = { {
+        { "beginner", 2, 2000, 50, 1500, false, false },
+        { "easy", 2, 5000, 100, 300, false, false },
+        { "medium", 3, 1500, 200, 300, false, false },
+        { "hard", SearchLimits::MaxDepth, 0, 300, 0, true, true },
+        { "expert", SearchLimits::MaxDepth, 0, 1000, 0, true, true },
+    } };
+
+    constexpr int DefaultDifficulty = 3;        //!< "hard", the computer player before levels existed
+}
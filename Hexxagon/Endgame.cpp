@@ -0,0 +1,177 @@
+#include "Endgame.h"
+#include <algorithm>
+
+namespace Hexxagon
+{
+    namespace
+    {
+        int margin(const Position& position)
+        {
+            return position.count(position.getSide()) - position.count(1 - position.getSide());
+        }
+
+        /// Returns empty cells, which the player can clone or jump to.
+        ///
+        Bitboard reach(const Position& position, int player)
+        {
+            const Topology& topology = position.getTopology();
+            Bitboard cells;
+            for (Bitboard own = position.getPieces(player); own; ) {
+                int from = own.popFirst();
+                cells |= topology.close(from) | topology.distant(from);
+            }
+            return cells & position.getEmpty();
+        }
+
+        /// Returns empty cells, which belong to connected
+        /// regions of empty cells of odd size.
+        ///
+        Bitboard oddRegions(const Position& position)
+        {
+            const Topology& topology = position.getTopology();
+            Bitboard odd;
+            for (Bitboard rest = position.getEmpty(); rest; ) {
+                Bitboard region = Bitboard::cell(rest.first());
+                for (Bitboard frontier = region; frontier; ) {
+                    Bitboard added = topology.close(frontier.popFirst()) & rest & ~region;
+                    region |= added;
+                    frontier |= added;
+                }
+                rest &= ~region;
+                if (region.count() % 2 == 1)
+                    odd |= region;
+            }
+            return odd;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    EndgameSolver::EndgameSolver(std::size_t table_megabytes) : table(table_megabytes) {}
+
+    ////////////////////////////////////////////////////////////
+    void EndgameSolver::clear() { table.clear(); }
+
+    ////////////////////////////////////////////////////////////
+    void EndgameSolver::scoreMoves(Position& position, const MoveList& moves, Move hash_move, bool mobility, int* scores) const
+    {
+        const Topology& topology = position.getTopology();
+        const Bitboard& opponent = position.getPieces(1 - position.getSide());
+        const Bitboard odd = oddRegions(position);
+        for (int i = 0; i < moves.size(); i++) {
+            const Move& move = moves[i];
+            if (move == hash_move) {
+                scores[i] = 1 << 20;
+                continue;
+            }
+            scores[i] = (topology.close(move.to) & opponent).count() * 64 + (move.isClone() ? 32 : 0) + (odd.test(move.to) ? 16 : 0);
+
+            if (mobility) {
+                Position::Undo undo = position.make(move);
+                scores[i] -= reach(position, position.getSide()).count();
+                position.unmake(undo);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    int EndgameSolver::solve(Position& position, int alpha, int beta, int plies_left, int ply)
+    {
+        if (node_limit != 0 && ++nodes >= node_limit)
+            stopped = true;
+        if (stopped)
+            return 0;
+        if (plies_left == 0 || position.isGameOver())
+            return margin(position);
+        if (std::ranges::find(path, position.getHash()) != path.end()) {
+            repeated = true;
+            return margin(position);
+        }
+
+        const int original_alpha = alpha;
+        Move hash_move{ 0, 0 };
+        if (const TranspositionTable::Entry* entry = table.probe(position.getHash())) {
+            hash_move = entry->move;
+            if (ply > 0 && entry->depth >= plies_left) {
+                if (entry->bound == TranspositionTable::Exact)
+                    return entry->score;
+                if (entry->bound == TranspositionTable::Lower && entry->score >= beta)
+                    return entry->score;
+                if (entry->bound == TranspositionTable::Upper && entry->score <= alpha)
+                    return entry->score;
+            }
+        }
+
+        MoveList moves;
+        position.generateMoves(moves);
+        int scores[MoveList::Capacity];
+        scoreMoves(position, moves, hash_move, plies_left > MobilityPlies, scores);
+
+        const bool outer_repeated = repeated;
+        repeated = false;
+        path.push_back(position.getHash());
+        int best_score = -Bitboard::Capacity - 1;
+        Move best_move = moves[0];
+        for (int i = 0; i < moves.size(); i++) {
+            // selection sort step: bring the best of remaining moves forward
+            int best_index = i;
+            for (int j = i + 1; j < moves.size(); j++)
+                if (scores[j] > scores[best_index])
+                    best_index = j;
+            std::swap(moves[i], moves[best_index]);
+            std::swap(scores[i], scores[best_index]);
+
+            Position::Undo undo = position.make(moves[i]);
+            int score = -solve(position, -beta, -alpha, plies_left - 1, ply + 1);
+            position.unmake(undo);
+
+            if (stopped)
+                break;
+
+            if (score > best_score) {
+                best_score = score;
+                best_move = moves[i];
+                if (ply == 0)
+                    root_move = best_move;
+                if (score > alpha)
+                    alpha = score;
+                if (alpha >= beta)
+                    break;
+            }
+        }
+        path.pop_back();
+        if (stopped)
+            return 0;
+
+        if (!repeated) {
+            TranspositionTable::Bound bound = best_score <= original_alpha ? TranspositionTable::Upper :
+                best_score >= beta ? TranspositionTable::Lower : TranspositionTable::Exact;
+            table.store(position.getHash(), best_score, plies_left, bound, best_move);
+        }
+        repeated |= outer_repeated;
+        return best_score;
+    }
+
+    ////////////////////////////////////////////////////////////
+    EndgameResult EndgameSolver::solve(const Position& root, std::uint64_t node_limit)
+    {
+        this->node_limit = node_limit;
+        nodes = 0;
+        stopped = false;
+        repeated = false;
+        path.clear();
+
+        EndgameResult result;
+        Position position = root;
+        if (position.isGameOver() || !position.hasMoves(position.getSide()))
+            return result;
+
+        int score = solve(position, -Bitboard::Capacity - 1, Bitboard::Capacity + 1, position.getEmpty().count() + 2, 0);
+        if (stopped)
+            return result;
+
+        result.move = root_move;
+        result.margin = score;
+        result.solved = true;
+        return result;
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Position.h"
+#include "Search.h"
+
+namespace Hexxagon
+{
+    struct EndgameResult
+    {
+        Move move;
+        int margin = 0;         //!< gamechips margin for the side to move, where best lines end or are cut
+        bool solved = false;    //!< 'false' if position has no moves or node limit was reached
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Solver of positions with few empty cells. Searches
+    /// every line to it's end or cut and returns the margin,
+    /// where the best line stops.
+    ///
+    /// Jumps keep the number of empty cells, so the game may
+    /// go on forever. Lines, which repeat a position or make
+    /// two steps more than there are empty cells at the root,
+    /// are cut there and scored by the gamechips on board.
+    /// A side, which is behind, can almost always jump until
+    /// the cut, so the margin is not the exact result of the
+    /// game, only of the game adjudicated at the cut.
+    /// Score of a repetition depends on the line, which led
+    /// to it, so positions searched through one aren't stored.
+    ////////////////////////////////////////////////////////////
+    class EndgameSolver
+    {
+    private:
+        TranspositionTable table;       //!< solved positions, kept apart from the table of the search
+
+        std::vector<std::uint64_t> path;        //!< keys of positions on the current line
+        std::uint64_t nodes = 0;
+        std::uint64_t node_limit = 0;
+        bool stopped = false;
+        bool repeated = false;      //!< a line was cut by repetition since it was last cleared
+        Move root_move;
+
+        int solve(Position& position, int alpha, int beta, int plies_left, int ply);
+
+        /// Scores moves for ordering: hash move first, then
+        /// captures, clones, cells in regions with odd number
+        /// of empty cells and moves leaving the opponent
+        /// fewer cells to reach. Mobility costs a step per move,
+        /// so it is counted far from the horizon only.
+        ///
+        void scoreMoves(Position& position, const MoveList& moves, Move hash_move, bool mobility, int* scores) const;
+
+        static constexpr int MobilityPlies = 3;
+
+    public:
+        static constexpr int EmptyThreshold = 6;    //!< positions with this many empty cells or less are solved
+
+        explicit EndgameSolver(std::size_t table_megabytes = 8);
+
+        /// Solves the position. Zero node limit means no limit.
+        ///
+        EndgameResult solve(const Position& position, std::uint64_t node_limit = 0);
+
+        void clear();       //!< forgets all solved positions
+    };
+}
@@ -0,0 +1,96 @@
+#include "Evaluation.h"
+#include <fstream>
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    void extractFeatures(const Position& position, Features& features)
+    {
+        const Topology& topology = position.getTopology();
+        const Bitboard empty = position.getEmpty();
+        const int side = position.getSide();
+
+        int frontier[2] = { 0, 0 };
+        int reach[2] = { 0, 0 };
+        for (int player : { Position::Red, Position::Blue }) {
+            Bitboard reachable;
+            for (Bitboard own = position.getPieces(player); own; ) {
+                int index = own.popFirst();
+                if (topology.close(index) & empty)
+                    frontier[player]++;
+                reachable |= topology.close(index) | topology.distant(index);
+            }
+            reachable &= empty;
+            reach[player] = reachable.count();
+
+            if (player == side) {
+                int best = 0;
+                for (Bitboard targets = reachable; targets; ) {
+                    int count = (topology.close(targets.popFirst()) & position.getPieces(1 - side)).count();
+                    best = count > best ? count : best;
+                }
+                features[BestCapture] = best;
+            }
+        }
+
+        features[Material] = position.count(side) - position.count(1 - side);
+        features[Frontier] = frontier[side] - frontier[1 - side];
+        features[Reach] = reach[side] - reach[1 - side];
+    }
+
+    ////////////////////////////////////////////////////////////
+    int evaluate(const Position& position, const EvalWeights& weights)
+    {
+        Features features;
+        extractFeatures(position, features);
+
+        int score = 0;
+        for (int i = 0; i < FeatureCount; i++)
+            score += features[i] * weights.weights[i];
+        return score;
+    }
+
+    ////////////////////////////////////////////////////////////
+    int finalScore(const Position& position)
+    {
+        int margin = position.count(position.getSide()) - position.count(1 - position.getSide());
+        if (margin > 0)
+            return WinScore + margin;
+        if (margin < 0)
+            return -WinScore + margin;
+        return 0;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool EvalWeights::load(const std::string& path)
+    {
+        std::fstream stream(path, std::ios::in);
+        if (!stream.is_open())
+            return false;
+
+        Features loaded = weights;
+        std::string name;
+        int weight;
+        while (stream >> name >> weight) {
+            int feature = 0;
+            while (feature < FeatureCount && name != FeatureNames[feature])
+                feature++;
+            if (feature == FeatureCount)
+                return false;
+            loaded[feature] = weight;
+        }
+        if (!stream.eof())
+            return false;
+        weights = loaded;
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool EvalWeights::save(const std::string& path) const
+    {
+        std::fstream stream(path, std::ios::out | std::ios::trunc);
+        for (int feature = 0; feature < FeatureCount; feature++)
+            stream << FeatureNames[feature] << " " << weights[feature] << "\n";
+        return (bool)stream;
+    }
+}
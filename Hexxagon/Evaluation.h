@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include "Position.h"
+
+namespace Hexxagon
+{
+    constexpr int WinScore = 30000;     //!< score of won game, final margin is added to it
+
+    ////////////////////////////////////////////////////////////
+    /// Terms of the evaluation. Each one is counted for the
+    /// side to move minus the same term for the opponent.
+    ////////////////////////////////////////////////////////////
+    enum Feature
+    {
+        Material,       //!< gamechips count
+        Frontier,       //!< gamechips next to an empty cell, which can be captured
+        Reach,          //!< empty cells reachable by a clone or a jump
+        BestCapture,    //!< most opponent's gamechips around one reachable cell, as getNearestGamechipCount counts them
+        FeatureCount
+    };
+
+    using Features = std::array<int, FeatureCount>;
+
+    constexpr const char* FeatureNames[FeatureCount] = { "material", "frontier", "reach", "best_capture" };
+
+    ////////////////////////////////////////////////////////////
+    /// Weights of the evaluation terms.
+    ////////////////////////////////////////////////////////////
+    struct EvalWeights
+    {
+        Features weights{ 100, -6, 3, 20 };
+
+        /// Reads weights file: lines of feature name and weight.
+        /// Returns 'false' if file is missing or has unknown
+        /// names, leaving weights unchanged.
+        ///
+        bool load(const std::string& path);
+
+        bool save(const std::string& path) const;
+    };
+
+    /// Counts evaluation terms of the position.
+    ///
+    void extractFeatures(const Position& position, Features& features);
+
+    /// Returns heuristic score of the position for the
+    /// side to move.
+    ///
+    int evaluate(const Position& position, const EvalWeights& weights);
+
+    /// Returns exact score of the finished game for the
+    /// side to move: WinScore plus final gamechips margin.
+    ///
+    int finalScore(const Position& position);
+}
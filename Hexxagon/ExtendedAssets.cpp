@@ -9,21 +9,25 @@ namespace sf
 		return clicked;
 	}
 
-	G_Button::G_Button(std::string button_name, const Vector2f& size) : RectangleShape(size) {
-		if (regular.loadFromFile("Assets\\" + button_name + "\\Regular.png")) {
-			setTexture(&regular);
-		}
-		else {
-			std::cout << "Regular texture could not load";
+	bool Button::wasChanged() {
+		if (changed) {
+			return !(changed = false);
 		}
+		return changed;
+	}
 
-		if (!pressed.loadFromFile("Assets\\" + button_name + "\\Pressed.png")) {
-			std::cout << "Pressed texture could not load";
-		}
+	G_Button::G_Button(std::string button_name, const Vector2f& size) : RectangleShape(size) {
+		AssetRegistry& assets = AssetRegistry::instance();
+		regular = assets.region("Assets\\" + button_name + "\\Regular.png");
+		pressed = assets.region("Assets\\" + button_name + "\\Pressed.png");
+		hover = assets.region("Assets\\" + button_name + "\\Hover.png");
+		show(regular);
+	}
 
-		if (!hover.loadFromFile("Assets\\" + button_name + "\\Hover.png")) {
-			std::cout << "Hover texture could not load";
-		}
+	void G_Button::show(const AtlasRegion& region) {
+		if (getTexture() != region.texture)
+			setTexture(region.texture);
+		setTextureRect(region.rect);
 	}
 	
 	bool G_Button::insideBounds(RenderWindow& window) const {
@@ -43,22 +47,21 @@ namespace sf
 
 			if (status != Pressed && event.type == sf::Event::MouseButtonPressed) {
 				status = Pressed;
-				setTexture(&pressed);
+				show(pressed);
+				changed = true;
 			}
 			else if ((status == Default && event.type == sf::Event::MouseMoved) || (status == Pressed && event.type == sf::Event::MouseButtonReleased)) {
-				sf::Cursor cursor;
-				if (cursor.loadFromSystem(sf::Cursor::Hand))
-					window.setMouseCursor(cursor);
+				window.setMouseCursor(AssetRegistry::instance().cursor(sf::Cursor::Hand));
 				status = Hovered;
-				setTexture(&hover);
+				show(hover);
+				changed = true;
 			}
 		}
 		else if (status != Default) {
-			sf::Cursor cursor;
-			if (cursor.loadFromSystem(sf::Cursor::Arrow))
-				window.setMouseCursor(cursor);
+			window.setMouseCursor(AssetRegistry::instance().cursor(sf::Cursor::Arrow));
 			status = Default;
-			setTexture(&regular);
+			show(regular);
+			changed = true;
 		}
 	}
 
@@ -99,10 +102,12 @@ namespace sf
 
 	void RadioButton::enable() {
 		checked = true;
+		changed = true;
 	}
 
 	void RadioButton::disable() {
 		checked = false;
+		changed = true;
 	}
 
 	bool RadioButton::isChecked() const {
@@ -113,9 +118,8 @@ namespace sf
 		if (insideBounds(window)) {
 			if (!hovered) {
 				hovered = true;
-				sf::Cursor cursor;
-				if (cursor.loadFromSystem(sf::Cursor::Hand))
-					window.setMouseCursor(cursor);
+				changed = true;
+				window.setMouseCursor(AssetRegistry::instance().cursor(sf::Cursor::Hand));
 			}
 			setOutlineThickness(4);
 			if(event.type == Event::MouseButtonPressed)
@@ -124,15 +128,14 @@ namespace sf
 		else {
 			if (hovered) {
 				hovered = false;
-				sf::Cursor cursor;
-				if (cursor.loadFromSystem(sf::Cursor::Arrow))
-					window.setMouseCursor(cursor);
+				changed = true;
+				window.setMouseCursor(AssetRegistry::instance().cursor(sf::Cursor::Arrow));
 			}
 			setOutlineThickness(0);
 		}
 	}
 
-	TextField::TextField(Vector2f size, Font& font, Color font_color, int character_size, int border_thickness, Color border_color) : 
+	TextField::TextField(Vector2f size, const Font& font, Color font_color, int character_size, int border_thickness, Color border_color) : 
 		text(font, "", character_size), 
 		rectangle(size), 
 		caret({ 2.f, size.y/3.f*2}) 
@@ -174,6 +177,7 @@ namespace sf
 	}
 
 	void TextField::type(Event event) {
+		changed = true;
 		std::string str = text.getString();
 		int key = event.key.code;
 
@@ -195,6 +199,7 @@ namespace sf
 	}
 
 	void TextField::moveCaret(int direction) {
+		changed = true;
 		if (direction == 1 && caret_shift <= text.getString().getSize()) {
 			if (caret_shift < text.getString().getSize() - 1) {
 				caret.setPosition({ text.findCharacterPos(caret_shift+1).x, caret.getPosition().y});
@@ -213,6 +218,7 @@ namespace sf
 	}
 
 	void TextField::clear() {
+		changed = true;
 		text.setString("");
 		caret_shift = 0;
 		caret.setPosition({rectangle.getPosition().x + 10.f, caret.getPosition().y});
@@ -226,6 +232,13 @@ namespace sf
 		return clicked;
 	}
 
+	bool TextField::wasChanged() {
+		if (changed) {
+			return !(changed = false);
+		}
+		return changed;
+	}
+
 	std::string TextField::getText() const {
 		return text.getString();
 	}
@@ -239,4 +252,50 @@ namespace sf
 		text.setPosition({text.getGlobalBounds().getPosition().x + position.x , position.y});
 		caret.setPosition({caret.getPosition().x + position.x, caret.getPosition().y + position.y});
 	}
+
+	FramePacer::FramePacer(RenderWindow& window) : window(window) {}
+
+	bool FramePacer::pollEvent(Event& event) {
+		bool received;
+		if (!dirty && !polling && !background)
+			received = window.waitEvent(event);
+		else {
+			if (!dirty && !polling)
+				std::this_thread::sleep_for(std::chrono::milliseconds(PollMilliseconds));
+			received = window.pollEvent(event);
+		}
+
+		polling = received;
+		if (!received)
+			background = false;
+		if (received && (event.type == Event::Resized || event.type == Event::GainedFocus || event.type == Event::MouseEntered))
+			dirty = true;
+
+		Profiler::instance().beginFrame();
+		if (received && (event.type == Event::MouseButtonPressed || event.type == Event::KeyPressed || event.type == Event::TextEntered))
+			Profiler::instance().inputReceived();
+		return received;
+	}
+
+	void FramePacer::invalidate() {
+		dirty = true;
+	}
+
+	void FramePacer::keepPolling() {
+		background = true;
+	}
+
+	bool FramePacer::needsRedraw() const {
+		return dirty;
+	}
+
+	void FramePacer::display() {
+		static const int display_section = Profiler::instance().section("display");
+		{
+			ProfileScope scope(display_section);
+			window.display();
+		}
+		Profiler::instance().endFrame();
+		dirty = false;
+	}
 }
\ No newline at end of file
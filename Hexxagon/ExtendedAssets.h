@@ -1,10 +1,14 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <chrono>
 #include <filesystem>
 #include <string>
+#include <thread>
 #include <iostream>
 #include <algorithm>
+#include "AssetRegistry.h"
+#include "Profiler.h"
 
 namespace sf
 {
@@ -17,6 +21,8 @@ namespace sf
 
 		bool clicked = false;
 
+		bool changed = false;
+
 		Button() {};
 
 	public:
@@ -27,13 +33,17 @@ namespace sf
 		/// Getters
 		///
 		bool wasClicked();		//!< returns 'true' if button was clicked recently
+
+		bool wasChanged();		//!< returns 'true' if button's look has changed since last call
 	};
 
 	class G_Button : public RectangleShape, public Button {
 	private:
-		Texture regular;
-		Texture pressed;
-		Texture hover;
+		AtlasRegion regular;
+		AtlasRegion pressed;
+		AtlasRegion hover;
+
+		void show(const AtlasRegion& region);		//!< switches button look to provided atlas region
 
 	protected:
 		bool insideBounds(RenderWindow& window) const;		//!< returns 'true' if mouse is inside button bounds
@@ -110,6 +120,7 @@ namespace sf
 		RectangleShape caret;
 
 		bool clicked = false;
+		bool changed = false;
 		int caret_shift = 0;
 
 		/// Basic text field logic, when
@@ -124,7 +135,7 @@ namespace sf
 
 		void draw(RenderTarget& target, const RenderStates& states) const;
 	public:
-		TextField(Vector2f size, Font& font, Color font_color, int character_size, int border_hickness, Color border_color);
+		TextField(Vector2f size, const Font& font, Color font_color, int character_size, int border_hickness, Color border_color);
 
 		/// Basic event handling.
 		///
@@ -147,6 +158,45 @@ namespace sf
 
 		bool wasClicked();
 
+		bool wasChanged();		//!< returns 'true' if text or caret has changed since last call
+
 		Vector2f getSize();
 	};
+
+	/// Render loop helper, which blocks on window events
+	/// while nothing was invalidated, so idle screens
+	/// don't redraw the same frame over and over.
+	/// Also marks frame bounds for the Profiler.
+	///
+	/// Screens waiting for background work, which doesn't
+	/// wake the event queue, call keepPolling() every loop:
+	/// the loop then naps instead of blocking, but doesn't
+	/// redraw until the work changes something.
+	///
+	class FramePacer {
+	private:
+		RenderWindow& window;
+
+		bool dirty = true;		//!< 'true' if next frame has to be drawn
+		bool polling = false;		//!< 'true' while pending events are being drained
+		bool background = false;		//!< 'true' if the loop waits for background work
+
+		static constexpr int PollMilliseconds = 10;		//!< nap between checks of background work
+
+	public:
+		FramePacer(RenderWindow& window);
+
+		/// Returns next window event. Waits for it, if
+		/// there is nothing to redraw.
+		///
+		bool pollEvent(Event& event);
+
+		void invalidate();		//!< requests redraw of the next frame
+
+		void keepPolling();		//!< makes next pollEvent() return without an event, for one loop
+
+		bool needsRedraw() const;		//!< returns 'true' if frame has been invalidated
+
+		void display();		//!< displays drawn frame and marks window as clean
+	};
 }
\ No newline at end of file
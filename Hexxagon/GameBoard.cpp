@@ -30,12 +30,11 @@ namespace Hexxagon
     /***********************************************************/
     /// StepField class methods initialisation.
     /***********************************************************/
-    StepField::StepField(float Radius, int pointCount) : Radius(Radius), sf::CircleShape(Radius, pointCount)
+    StepField::StepField(float Radius, int pointCount, ChipPool* chips) : Radius(Radius), chips(chips), sf::CircleShape(Radius, pointCount)
     {
         this->ID     = ++count;
         this->radius = sqrt(3) / 2.f * Radius;
         isSelected   = false;
-        gameChip     = nullptr;
 
         setFillColor(sf::Color::White);
         setOutlineColor(sf::Color::Transparent);
@@ -43,24 +42,84 @@ namespace Hexxagon
     }
 
     ////////////////////////////////////////////////////////////
-    bool StepField::isOccupied() const { return gameChip != nullptr; }
+    void StepField::paintFill(const sf::Color& color)
+    {
+        if (isHovered)
+            setFillColor(sf::Color(color.r * 4 / 5, color.g * 4 / 5, color.b * 4 / 5, color.a));
+        else
+            setFillColor(color);
+        changed = true;
+    }
 
     ////////////////////////////////////////////////////////////
-    GameChip* StepField::getGameChip() const { return gameChip; }
+    void StepField::paintOutline(const sf::Color& color)
+    {
+        setOutlineColor(color);
+        changed = true;
+    }
 
     ////////////////////////////////////////////////////////////
-    void StepField::occupy(GameChip* chip)
+    void StepField::writeVertices(sf::Vertex* vertices) const
+    {
+        const float pi     = 3.141592654f;
+        const sf::Vector2f center(getPosition().x + Radius, getPosition().y + Radius);
+        const float outer  = Radius + getOutlineThickness() / std::cos(pi / 6.f);   // same miter as sf::Shape outline
+
+        sf::Vector2f inner_p[6];
+        sf::Vector2f outer_p[6];
+        for (int i = 0; i < 6; i++) {
+            float angle = i * 2.f * pi / 6.f - pi / 2.f;
+            inner_p[i] = { center.x + std::cos(angle) * Radius, center.y + std::sin(angle) * Radius };
+            outer_p[i] = { center.x + std::cos(angle) * outer, center.y + std::sin(angle) * outer };
+        }
+
+        const sf::Color fill = getFillColor();
+        const sf::Color outline = getOutlineColor();
+        for (int i = 0; i < 6; i++) {
+            int next = (i + 1) % 6;
+            sf::Vertex* v = vertices + i * 9;
+
+            v[0] = { center, fill };
+            v[1] = { inner_p[i], fill };
+            v[2] = { inner_p[next], fill };
+
+            v[3] = { inner_p[i], outline };
+            v[4] = { outer_p[i], outline };
+            v[5] = { outer_p[next], outline };
+            v[6] = { inner_p[i], outline };
+            v[7] = { outer_p[next], outline };
+            v[8] = { inner_p[next], outline };
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool StepField::isOccupied() const { return gameChip >= 0; }
+
+    ////////////////////////////////////////////////////////////
+    GameChip* StepField::getGameChip() const { return gameChip >= 0 ? &(*chips)[gameChip] : nullptr; }
+
+    ////////////////////////////////////////////////////////////
+    void StepField::occupy(int chip)
     {
         gameChip = chip;
-        chip->setField(this);
-        setFillColor(chip->getColor());
+        (*chips)[chip].setField(this);
+        paintFill((*chips)[chip].getColor());
     }
 
     ////////////////////////////////////////////////////////////
-    void StepField::makeFree()
+    int StepField::makeFree()
     {
-        this->gameChip = nullptr;
-        setFillColor(sf::Color::White);
+        int chip = gameChip;
+        gameChip = -1;
+        paintFill(sf::Color::White);
+        return chip;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void StepField::capture(sf::Color color)
+    {
+        (*chips)[gameChip].setColor(color);
+        paintFill(color);
     }
 
     ////////////////////////////////////////////////////////////
@@ -69,33 +128,33 @@ namespace Hexxagon
         if (selected && isOccupied())
         {
             isSelected = true;
-            setOutlineColor(sf::Color::Yellow);
+            paintOutline(sf::Color::Yellow);
             for (StepField* neighbour : neighbours)
             {
                 if (!neighbour->isOccupied())
-                    neighbour->setOutlineColor(sf::Color::Green);
+                    neighbour->paintOutline(sf::Color::Green);
             }
             for (StepField* neighbour : neighbours)
             {
                 for (StepField* stepField : neighbour->getCloseNeighbours())
                 {
                     if (stepField->getOutlineColor() == sf::Color::Transparent && !stepField->isOccupied())
-                        stepField->setOutlineColor(sf::Color::Yellow);
+                        stepField->paintOutline(sf::Color::Yellow);
                 }
             }
         }
         else {
             isSelected = false;
-            setOutlineColor(sf::Color::Transparent);
+            paintOutline(sf::Color::Transparent);
             for (StepField* neighbour : neighbours)
             {
-                neighbour->setOutlineColor(sf::Color::Transparent);
+                neighbour->paintOutline(sf::Color::Transparent);
             }
             for (StepField* neighbour : neighbours) {
                 for (StepField* stepField : neighbour->getCloseNeighbours())
                 {
                     if (stepField->getOutlineColor() != sf::Color::Transparent)
-                        stepField->setOutlineColor(sf::Color::Transparent);
+                        stepField->paintOutline(sf::Color::Transparent);
                 }
             }
         }
@@ -117,19 +176,29 @@ namespace Hexxagon
     ////////////////////////////////////////////////////////////
     bool StepField::isDistantNeighbourOf(StepField* field) const 
     {
-        for (StepField* f : field->getCloseNeighbours())
-            if (isCloseNeighbourOf(f))
-                return true;
-        return false;
+        return std::ranges::find(distantNeighbours, field) != distantNeighbours.end();
     }
 
     ////////////////////////////////////////////////////////////
-    bool StepField::mouseEvent(sf::RenderWindow& window) const 
+    bool StepField::contains(sf::Vector2f point) const
     {
-        sf::Vector2f worldPos = window.mapPixelToCoords(sf::Mouse::getPosition(window));
-        return sqrt(pow((int)(worldPos.x - (getPosition().x + Radius)), 2) + pow((int)(worldPos.y - (getPosition().y + Radius)), 2)) <= radius;
+        float dx = point.x - (getPosition().x + Radius);
+        float dy = point.y - (getPosition().y + Radius);
+        return dx * dx + dy * dy <= radius * radius;
     }
 
+    ////////////////////////////////////////////////////////////
+    void StepField::setHovered(bool hovered)
+    {
+        if (isHovered != hovered) {
+            isHovered = hovered;
+            paintFill(isOccupied() ? getGameChip()->getColor() : sf::Color::White);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void StepField::setMarked(const sf::Color& color) { paintOutline(color); }
+
     ////////////////////////////////////////////////////////////
     int StepField::getID() const { return ID; }
 
@@ -146,17 +215,7 @@ namespace Hexxagon
     std::vector<StepField*> StepField::getCloseNeighbours() const { return neighbours; }
 
     ////////////////////////////////////////////////////////////
-    std::vector<StepField*> StepField::getDistantNeighbours() const
-    {
-        std::set<StepField*> s{};
-        for (StepField* field : neighbours) {
-            s.insert_range(field->getCloseNeighbours());
-        }
-        for (StepField* field : neighbours) {
-            std::erase_if(s, [field](StepField* f)->bool {return f == field; });
-        }
-        return std::vector<StepField*>(s.begin(), s.end());
-    };
+    const std::vector<StepField*>& StepField::getDistantNeighbours() const { return distantNeighbours; }
 
     ////////////////////////////////////////////////////////////
     std::vector<StepField*> StepField::getFreeCloseNeighbours() const
@@ -170,7 +229,7 @@ namespace Hexxagon
     ////////////////////////////////////////////////////////////
     std::vector<StepField*> StepField::getFreeDistantNeighbours() const
     {
-        std::vector<StepField*> v = getDistantNeighbours();
+        std::vector<StepField*> v(distantNeighbours);
         auto range = std::ranges::remove_if(v, [](StepField* f) -> bool {return f == nullptr || f->isOccupied(); });
         v.erase(range.begin(), range.end());
         return v;
@@ -193,27 +252,28 @@ namespace Hexxagon
     ////////////////////////////////////////////////////////////
     void Board::GameStatus::calculateProgress()
     {
+        static const int progress_section = sf::Profiler::instance().section("progress");
+        sf::ProfileScope scope(progress_section);
         if (is_running) {
             points_r = 0;
             points_b = 0;
             bool r_step = false;
             bool b_step = false;
-            int fields_count = 0;
-
-            for (std::vector<StepField*> list : board->fields) {
-                auto ra_1 = std::ranges::partition(list.begin(), list.end(), [](StepField* f)->bool {return f != nullptr && f->isOccupied(); });
-                auto ra_2 = std::ranges::partition(list.begin(), ra_1.begin(), [](StepField* f)->bool {return f->getGameChip()->getColor() == sf::Color::Red; });
-                for (auto i = list.begin(); i < ra_2.begin() && !r_step; i++) {
-                    if ((*i)->getGameChip()->canMakeStep())
+            int fields_count = board->fields.size();
+
+            for (StepField* field : board->fields) {
+                if (!field->isOccupied())
+                    continue;
+                if (field->getGameChip()->getColor() == sf::Color::Red) {
+                    points_r++;
+                    if (!r_step && field->getGameChip()->canMakeStep())
                         r_step = true;
                 }
-                for (auto i = ra_2.begin(); i < ra_1.begin() && !b_step; i++) {
-                    if ((*i)->getGameChip()->canMakeStep())
+                else {
+                    points_b++;
+                    if (!b_step && field->getGameChip()->canMakeStep())
                         b_step = true;
                 }
-                points_r += ra_2.begin() - list.begin();
-                points_b += ra_1.begin() - ra_2.begin();
-                fields_count += list.size();
             }
             if (points_r == 0 || points_b == 0 || points_r + points_b >= fields_count || !r_step || !b_step) {
                 time_t t = std::time(nullptr);
@@ -270,14 +330,18 @@ namespace Hexxagon
     /***********************************************************/
     /// Board class methods initialisation.
     /***********************************************************/
-     Board::Board(float fieldRadius, std::string file_name) : 
+     Board::Board(float fieldRadius, std::string file_name, const Topology& topology) : 
          save_name(file_name),
          loaded(true),
          fieldRadius(fieldRadius), 
-         AI(HexxagonAI(this)), 
-         progress(new GameStatus(this)) 
+         AI(this), 
+         progress(new GameStatus(this)),
+         topology(&topology),
+         cells(topology.cellCount()),
+         chips(topology.cellCount())
      {
          generateField();
+         IoWorker::instance().flush();
          std::fstream stream = std::fstream("Saves\\" + file_name + (file_name.ends_with(".bin") ? "" : ".bin"), std::ios::in | std::ios::binary);
          int buff;
          for(int i = 0; i < 9; i++)
@@ -299,104 +363,132 @@ namespace Hexxagon
              }
          }
          unsigned int field_status = 0;
-         for (const std::vector<StepField*> list : fields) {
-             for(StepField* field : list){
+         for (int i = 0; i < topology.rows(); i++) {
+             for (int j = 0; j < topology.rowLength(i); j++) {
+                 StepField* field = fieldAt(i, j);
                  stream >> field_status;
-                 if (field != nullptr && field_status & 0b100) {
-                     field->occupy(new GameChip((field_status & 0b10 ? sf::Color::Blue : sf::Color::Red), field));
-                     field->setSelected(field_status & 1);
+                 if (field == nullptr)
+                     continue;
+                 if (!(field_status & 0b100)) {
+                     if (field->isOccupied())       // start gamechip, which the save doesn't have
+                         chips.release(field->makeFree());
+                     continue;
                  }
+                 const sf::Color color = field_status & 0b10 ? sf::Color::Blue : sf::Color::Red;
+                 if (field->isOccupied())
+                     field->capture(color);
+                 else
+                     field->occupy(chips.acquire(color, field));
+                 field->setSelected(field_status & 1);
              }
          }
+         start_position = toPosition();
+         if (isComputerTurn() && !start_position.isGameOver())
+             AI.makeStep();     // older saves could be written before computer's reply
      }
 
     ////////////////////////////////////////////////////////////
-    Board::Board(float fieldRadius, bool AI_game) : fieldRadius(fieldRadius), AI_game(AI_game), AI(HexxagonAI(this)), progress(new GameStatus(this))
+    Board::Board(float fieldRadius, bool AI_game, const Topology& topology) : 
+        fieldRadius(fieldRadius), 
+        AI_game(AI_game), 
+        AI(this), 
+        progress(new GameStatus(this)),
+        topology(&topology),
+        cells(topology.cellCount()),
+        chips(topology.cellCount())
     {
         generateField();
+        start_position = toPosition();
     }
 
     ////////////////////////////////////////////////////////////
     Board::~Board(){
-        delete selected_f;
         delete progress;
     }
 
     ////////////////////////////////////////////////////////////
     void Board::generateField() {
-        for (int i = 0; i < 9; i++)
-        {
-            fields.push_back(std::vector<StepField*>{});
-            for (int j = 0; j < 9 - abs(i - 4); j++)
-            {
-                if (!(((i == 3 || i == 5) && j == 4) || (i == 4 && j == 3)))
-                {
-                    fields[i].push_back(new StepField(fieldRadius, 6));
-                    if (i - 1 >= 0) {
-                        if (i < 5 && j > 0 && fields[i - 1][j - 1] != nullptr)
-                            fields[i - 1][j - 1]->addNeighbour(fields[i][j]);
-                        else if (i >= 5 && j < fields[i - 1].size() && fields[i - 1][j + 1] != nullptr)
-                            fields[i - 1][j + 1]->addNeighbour(fields[i][j]);
-
-                        if (j < fields[i - 1].size() && fields[i - 1][j] != nullptr)
-                            fields[i - 1][j]->addNeighbour(fields[i][j]);
-                    }
+        for (int i = 0; i < topology->cellCount(); i++)
+            fields.push_back(&cells[cells.acquire(fieldRadius, 6, &chips)]);
 
-                    if (j > 0 && fields[i][j - 1] != nullptr)
-                        fields[i][j - 1]->addNeighbour(fields[i][j]);
-                }
-                else
-                    fields[i].push_back(nullptr);
+        for (int i = 0; i < topology->cellCount(); i++)
+        {
+            for (Bitboard close = topology->close(i); close; ) {
+                int j = close.popFirst();
+                if (j > i)
+                    fields[i]->addNeighbour(fields[j]);
             }
+            for (Bitboard distant = topology->distant(i); distant; )
+                fields[i]->distantNeighbours.push_back(fields[distant.popFirst()]);
+        }
 
-            if (fields[i].size() == 5)
-            {
-                fields[i][0]->occupy(new GameChip(sf::Color::Blue, fields[i][0]));
-                fields[i][fields[i].size() - 1]->occupy(new GameChip(sf::Color::Red, fields[i][0]));
-            }
-            if (fields[i].size() == 9)
-            {
-                fields[i][0]->occupy(new GameChip(sf::Color::Red, fields[i][0]));
-                fields[i][fields[i].size() - 1]->occupy(new GameChip(sf::Color::Blue, fields[i][0]));
-            }
+        for (Bitboard start = topology->start(0); start; ) {
+            StepField* field = fields[start.popFirst()];
+            field->occupy(chips.acquire(sf::Color::Red, field));
         }
+        for (Bitboard start = topology->start(1); start; ) {
+            StepField* field = fields[start.popFirst()];
+            field->occupy(chips.acquire(sf::Color::Blue, field));
+        }
+
+        for (int i = 0; i < fields.size(); i++)
+            fields[i]->vertexIndex = i * StepField::VertexCount;
+        vertices.resize(fields.size() * StepField::VertexCount);
+
         yDistance = fieldRadius * 0.86602540378443864676372317075294f; //sqrt(3)/2
-        size = 9.f * (yDistance * 2 + 4);
+        size = topology->rows() * (yDistance * 2 + 4);
         initFieldsLocation();
     }
 
+    ////////////////////////////////////////////////////////////
+    StepField* Board::fieldAt(int row, int column) const
+    {
+        int index = topology->index(row, column);
+        return index < 0 ? nullptr : fields[index];
+    }
+
     ////////////////////////////////////////////////////////////
     void Board::draw(sf::RenderTarget& target, const sf::RenderStates& states) const
     {
-        for (const std::vector<StepField*>& list : fields)
-            for (StepField* field : list) {
-                if (field != nullptr)
-                    target.draw(*field, states);
+        for (StepField* field : fields) {
+            if (field->changed) {
+                field->writeVertices(&vertices[field->vertexIndex]);
+                field->changed = false;
             }
+        }
+        target.draw(vertices, states);
     }
 
     ////////////////////////////////////////////////////////////
     void Board::initFieldsLocation()
     {
-        float y_shift = getPosition().y;
-
-        for (int i = 0; i < fields.size(); i++)
+        for (int i = 0; i < topology->rows(); i++)
         {
-            float x_shift = getPosition().x;
-
-            for (int j = abs(i - 4); j > 0; j--)
-                x_shift += fieldRadius;
-
-            for (int j = 0; j < fields[i].size(); j++)
+            for (int j = 0; j < topology->rowLength(i); j++)
             {
-                if (fields[i][j] != nullptr)
-                    fields[i][j]->setPosition({ x_shift, y_shift });
-                x_shift += fieldRadius * 2;
+                if (StepField* field = fieldAt(i, j)) {
+                    field->setPosition(getPosition() + fieldLocation(*topology, fieldRadius, i, j));
+                    field->changed = true;
+                }
             }
-            y_shift += yDistance * 2 + 2;
         }
     }
 
+    ////////////////////////////////////////////////////////////
+    sf::Vector2f Board::fieldLocation(const Topology& topology, float fieldRadius, int row, int column)
+    {
+        const float yDistance = fieldRadius * 0.86602540378443864676372317075294f; //sqrt(3)/2
+        return { (std::abs(row - topology.radius()) + column * 2) * fieldRadius, row * (yDistance * 2 + 2) };
+    }
+
+    ////////////////////////////////////////////////////////////
+    float Board::fitFieldRadius(const Topology& topology, float size)
+    {
+        const int rows = topology.rows();
+        const float radius = std::min(size / (rows * 2.f), (size / rows - 2.f) / (2 * 0.86602540378443864676372317075294f));
+        return std::max(radius, 1.f);
+    }
+
     ////////////////////////////////////////////////////////////
     void Board::setLocation(int x, int y)
     {
@@ -411,27 +503,66 @@ namespace Hexxagon
         }
     }
 
+    ////////////////////////////////////////////////////////////
+    StepField* Board::fieldAt(sf::Vector2f point) const
+    {
+        float x = point.x - getPosition().x - fieldRadius;
+        float y = point.y - getPosition().y - fieldRadius;
+
+        // row 'r' and column 'q' of the axial grid, where the central cell is (0, 0)
+        float R = (float)topology->radius();
+        float r = y / (yDistance * 2 + 2) - R;
+        float q = (x - 2.f * R * fieldRadius) / (2.f * fieldRadius) - r / 2.f;
+        float s = -q - r;
+
+        float rq = std::round(q);
+        float rr = std::round(r);
+        float rs = std::round(s);
+        float dq = std::abs(rq - q);
+        float dr = std::abs(rr - r);
+        float ds = std::abs(rs - s);
+        if (dq > dr && dq > ds)
+            rq = -rr - rs;
+        else if (dr > ds)
+            rr = -rq - rs;
+
+        StepField* field = fieldAt((int)(rr + R), (int)(rq + R) + std::min((int)rr, 0));
+        return field != nullptr && field->contains(point) ? field : nullptr;
+    }
+
     ////////////////////////////////////////////////////////////
     void Board::mousePressed(sf::RenderWindow& window)
     {
-        bool pressed = false;
+        if (!progress->isRunning() || isComputerTurn())
+            return;
 
-        for (int i = 0; progress->isRunning() && i < fields.size() && !pressed; i++)
+        StepField* field = fieldAt(window.mapPixelToCoords(sf::Mouse::getPosition(window)));
+        if (field != nullptr)
         {
-            for (int j = 0; j < fields[i].size() && !pressed; j++)
-            {
-                if (fields[i][j] != nullptr && fields[i][j]->mouseEvent(window))
-                {
-                    if (fields[i][j] != selected_f && fields[i][j]->isOccupied() &&
-                        ((player == 0 && fields[i][j]->getGameChip()->getColor() == sf::Color::Red) ||
-                            (player == 1 && fields[i][j]->getGameChip()->getColor() == sf::Color::Blue))) {
-                        clearSelected();
-                        fields[i][j]->setSelected(true);
-                        selected_f = fields[i][j];
-                    } else
-                        makeStep(fields[i][j]);
-                }
-            }
+            if (field != selected_f && field->isOccupied() &&
+                ((player == 0 && field->getGameChip()->getColor() == sf::Color::Red) ||
+                    (player == 1 && field->getGameChip()->getColor() == sf::Color::Blue))) {
+                clearSelected();
+                field->setSelected(true);
+                selected_f = field;
+            } else
+                makeStep(field);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Board::mouseMoved(sf::RenderWindow& window)
+    {
+        StepField* field = nullptr;
+        if (progress->isRunning())
+            field = fieldAt(window.mapPixelToCoords(sf::Mouse::getPosition(window)));
+
+        if (field != hovered_f) {
+            if (hovered_f != nullptr)
+                hovered_f->setHovered(false);
+            if (field != nullptr)
+                field->setHovered(true);
+            hovered_f = field;
         }
     }
 
@@ -440,35 +571,117 @@ namespace Hexxagon
     {
         if (selected_f != nullptr && field != nullptr && !field->isOccupied())
         {
+            bool stepped = true;
+            const int mover = player;
+            Move move;
+            move.to = (std::uint8_t)(std::ranges::find(fields, field) - fields.begin());
+            move.from = field->isCloseNeighbourOf(selected_f) ? move.to : (std::uint8_t)(std::ranges::find(fields, selected_f) - fields.begin());
             if (field->isCloseNeighbourOf(selected_f))
                 doubleCheap(*selected_f->getGameChip(), field);
             else if (field->isDistantNeighbourOf(selected_f))
                 moveCheap(selected_f->getGameChip(), field);
+            else
+                stepped = false;
             progress->calculateProgress();
 
-        if (AI_game && player == 1)
-            AI.makeStep();
+            if (stepped)
+                history.push_back(move);
+            if (stepped && step_listener)
+                step_listener(move, mover);
+
+            if (stepped)
+                steps_since_save++;
+            const bool replying = isComputerTurn();     // a save now would give computer's turn to the human
+            if (autosave_steps > 0 && steps_since_save >= autosave_steps && !replying && progress->isRunning()) {
+                steps_since_save = 0;
+                save(save_name.empty() ? "autosave" : save_name);
+            }
+
+            if (replying)
+                AI.makeStep();
         }
 
         clearSelected();
     }
 
     ////////////////////////////////////////////////////////////
-    void Board::doubleCheap(GameChip& chip, StepField* field)
+    void Board::play(Move move)
+    {
+        clearSelected();
+        selected_f = sourceOf(move);
+        makeStep(fields[move.to]);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Board::showHint(Move move)
+    {
+        clearSelected();
+        selected_f = sourceOf(move);
+        selected_f->setSelected(true);
+        fields[move.to]->setMarked(sf::Color::Cyan);
+    }
+
+    ////////////////////////////////////////////////////////////
+    StepField* Board::sourceOf(Move move) const
+    {
+        StepField* source = fields[move.from];
+        sf::Color color = player == 0 ? sf::Color::Red : sf::Color::Blue;
+        if (move.isClone()) {
+            for (Bitboard close = topology->close(move.to); close; ) {
+                StepField* neighbour = fields[close.popFirst()];
+                if (neighbour->isOccupied() && neighbour->getGameChip()->getColor() == color) {
+                    source = neighbour;
+                    break;
+                }
+            }
+        }
+        return source;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Board::setState(const Position& position)
+    {
+        clearSelected();
+        for (int i = 0; i < (int)fields.size(); i++) {
+            StepField* field = fields[i];
+            field->setMarked(sf::Color::Transparent);
+            const bool red = position.getPieces(Position::Red).test(i);
+            if (!red && !position.getPieces(Position::Blue).test(i)) {
+                if (field->isOccupied())
+                    chips.release(field->makeFree());
+                continue;
+            }
+            const sf::Color color = red ? sf::Color::Red : sf::Color::Blue;
+            if (!field->isOccupied())
+                field->occupy(chips.acquire(color, field));
+            else if (field->getGameChip()->getColor() != color)
+                field->capture(color);
+        }
+        player = position.getSide() == Position::Red ? 0 : 1;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Board::markMove(Move move, const sf::Color& color)
+    {
+        fields[move.from]->setMarked(color);
+        fields[move.to]->setMarked(color);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Board::doubleCheap(const GameChip& chip, StepField* field)
     {
         if (chip.getColor() == sf::Color::Red)
             progress->addRedScore(10);
         else
             progress->addBlueScore(10);
-        field->occupy(new GameChip(chip.getColor(), field));
+        field->occupy(chips.acquire(chip.getColor(), field));
         checkNeighbours(field->getGameChip());
     }
 
     ////////////////////////////////////////////////////////////
     void Board::moveCheap(GameChip* chip, StepField* field)
     {
-        chip->getField()->makeFree();
-        field->occupy(chip);
+        field->occupy(chip->getField()->makeFree());
         checkNeighbours(field->getGameChip());
     }
 
@@ -481,7 +694,7 @@ namespace Hexxagon
                     progress->addRedScore(30);
                 else
                     progress->addBlueScore(30);
-                neighbour->occupy(chip);
+                neighbour->capture(chip->getColor());
             }
         nextPlayer();
     }
@@ -490,20 +703,29 @@ namespace Hexxagon
     Board::GameStatus* Board::getGameProgress() const { return progress; }
 
     ////////////////////////////////////////////////////////////
-    std::vector<StepField*> Board::getFields() const {
-        std::vector<StepField*> v{};
-        for (std::vector<StepField*> list : fields) {
-            v.insert(v.begin(), list.begin(), list.end());
-        }
-        return v;
-    }
+    const std::vector<StepField*>& Board::getFields() const { return fields; }
+
+    ////////////////////////////////////////////////////////////
+    const Topology& Board::getTopology() const { return *topology; }
+
+    ////////////////////////////////////////////////////////////
+    const HexxagonAI& Board::getAI() const { return AI; }
 
     ////////////////////////////////////////////////////////////
     void Board::nextPlayer() { player = abs(player - 1); }
 
     ////////////////////////////////////////////////////////////
     void Board::save(std::string file_name) {
-        std::fstream stream = std::fstream("Saves\\" + file_name + (file_name.ends_with(".bin") ? "" : ".bin"), std::ios::out | std::ios::trunc);
+        static const int save_section = sf::Profiler::instance().section("save");
+        sf::ProfileScope scope(save_section);
+        std::string contents = serialize();
+        SaveIndex::instance().update(file_name, toPosition(), AI_game, contents.size());
+        IoWorker::instance().write("Saves\\" + file_name + (file_name.ends_with(".bin") ? "" : ".bin"), std::move(contents));
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::string Board::serialize() const {
+        std::ostringstream stream;
         stream << progress->points_r << '\n';
         stream << progress->points_b << '\n';
         stream << progress->red_score << '\n';
@@ -514,8 +736,9 @@ namespace Hexxagon
         stream << player << '\n';
         stream << AI_game << '\n';
         unsigned int field_status = 0;
-        for (const std::vector<StepField*> list : fields) {
-            for (StepField* field : list) {
+        for (int i = 0; i < topology->rows(); i++) {
+            for (int j = 0; j < topology->rowLength(i); j++) {
+                StepField* field = fieldAt(i, j);
                 if (field != nullptr && field->getGameChip() != nullptr) {
                     field_status |= (field->isOccupied() << 2);
                     if (field_status) {
@@ -523,7 +746,6 @@ namespace Hexxagon
                         field_status |= field->isSelected;
                     }
                     stream << field_status << "\n";
-                    stream;
                 }
                 else {
                     field_status &= 0;
@@ -532,12 +754,56 @@ namespace Hexxagon
                 field_status = 0;
             }
         }
-        stream.close();
+        return stream.str();
     }
 
+    ////////////////////////////////////////////////////////////
+    void Board::setAutosave(int steps) { autosave_steps = steps; }
+
+    ////////////////////////////////////////////////////////////
+    void Board::setDifficulty(int level) { AI.setDifficulty(level); }
+
+    ////////////////////////////////////////////////////////////
+    void Board::setStepListener(std::function<void(Move, int)> listener) { step_listener = std::move(listener); }
+
+    ////////////////////////////////////////////////////////////
+    int Board::getPlayer() const { return player; }
+
+    ////////////////////////////////////////////////////////////
+    bool Board::isComputerTurn() const { return AI_game && player == 1; }
+
+    ////////////////////////////////////////////////////////////
+    bool Board::playComputerStep() { return AI.finishStep(); }
+
+    ////////////////////////////////////////////////////////////
+    const Position& Board::getStartPosition() const { return start_position; }
+
+    ////////////////////////////////////////////////////////////
+    const std::vector<Move>& Board::getHistory() const { return history; }
+
     ////////////////////////////////////////////////////////////
     std::string Board::getSaveName() const { return save_name; }
 
     ////////////////////////////////////////////////////////////
     bool Board::wasLoaded() const { return loaded; }
+
+    ////////////////////////////////////////////////////////////
+    bool Board::isChanged() const
+    {
+        return std::ranges::any_of(fields, [](StepField* f) -> bool { return f->changed; });
+    }
+
+    ////////////////////////////////////////////////////////////
+    Position Board::toPosition() const
+    {
+        Position position(*topology);
+        for (int i = 0; i < topology->cellCount(); i++) {
+            if (!fields[i]->isOccupied())
+                position.clear(i);
+            else
+                position.place(i, fields[i]->getGameChip()->getColor() == sf::Color::Red ? Position::Red : Position::Blue);
+        }
+        position.setSide(player == 0 ? Position::Red : Position::Blue);
+        return position;
+    }
 };
\ No newline at end of file
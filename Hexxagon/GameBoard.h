@@ -1,13 +1,22 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
 #include <vector>
 #include <set>
 #include <string>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <sstream>
 #include <SFML/Graphics.hpp>
 #include "HexxagonAI.h"
+#include "IoWorker.h"
+#include "Pool.h"
+#include "Profiler.h"
+#include "SaveIndex.h"
+#include "Position.h"
+#include "Topology.h"
 
 namespace Hexxagon
 {
@@ -41,6 +50,8 @@ namespace Hexxagon
         bool canMakeStep() const;      //!< returns 'true' if surrounded from all sides.
     };
 
+    using ChipPool = Pool<GameChip>;
+
     ////////////////////////////////////////////////////////////
     /// Game board cell class, whose objects will
     /// contain GameChip objects and will be rendered
@@ -53,35 +64,55 @@ namespace Hexxagon
     private:
         int ID;
         bool isSelected = false;
+        bool isHovered = false;
+        bool changed = true;        //!< 'true' if cell's geometry has to be rewritten into board's vertex array
+
+        std::size_t vertexIndex = 0;        //!< index of the first cell's vertex in board's vertex array
 
-        GameChip* gameChip;
+        int gameChip = -1;      //!< index of contained gamechip in board's pool, -1 if empty
+
+        ChipPool* chips;        //!< board's pool of gamechips
 
         float Radius;       //!< The radius of the circumscribed circle
         float radius;       //!< The radius of the inscribed circle
 
         std::vector<StepField*> neighbours;     //!< vector of neighbour game board cells
 
+        std::vector<StepField*> distantNeighbours;      //!< game board cells at distance 2, reachable by jumping
+
+        void paintFill(const sf::Color& color);       //!< sets fill color and marks cell as changed
+
+        void paintOutline(const sf::Color& color);    //!< sets outline color and marks cell as changed
+
+        /// Writes cell's fill and outline triangles
+        /// into provided vertex array slice.
+        ///
+        void writeVertices(sf::Vertex* vertices) const;
+
     public:
+        static constexpr std::size_t VertexCount = 6 * 3 * 3;    //!< vertices per cell: 6 fill triangles + 6 outline quads
 
-        StepField(float Radius, int pointCount);
+        StepField(float Radius, int pointCount, ChipPool* chips);
 
         bool isOccupied() const;      //!< returns 'true' if contains gamechip
 
-        void occupy(GameChip* chip);    //!< sets gamechip to gameChip variable
+        void occupy(int chip);    //!< places gamechip with provided pool index into the cell
 
-        void makeFree();        //!< removes gamechip from gameChip variable
+        int makeFree();        //!< removes gamechip from the cell and returns it's pool index
+
+        void capture(sf::Color color);      //!< recolors contained gamechip to the capturer's color
 
         void addNeighbour(StepField* stepField);
 
         bool isCloseNeighbourOf(StepField* field) const;      //!< returns 'true' if neighbours vector contains 'field' pointer
 
-        bool isDistantNeighbourOf(StepField* field) const;      //!< returns 'true' if any neighbour contains neighbour with 'field' pointer
+        bool isDistantNeighbourOf(StepField* field) const;      //!< returns 'true' if distantNeighbours vector contains 'field' pointer
 
         bool isBorder() const{
             return std::ranges::find_if(neighbours, [](StepField* f) -> bool { return f != nullptr && !f->isOccupied(); }) != neighbours.end();
         }
 
-        bool mouseEvent(sf::RenderWindow& window) const;      //!< returns 'true' if mouse pressed on field area, selects it and it's empty neighbours
+        bool contains(sf::Vector2f point) const;      //!< returns 'true' if point lies inside inscribed circle of the cell
 
         GameChip* getGameChip() const;
 
@@ -91,11 +122,15 @@ namespace Hexxagon
 
         void setSelected(bool selected);
 
+        void setHovered(bool hovered);      //!< shades the cell while mouse is over it
+
+        void setMarked(const sf::Color& color);     //!< outlines the cell with provided color, transparent removes the mark
+
         int getNearestGamechipCount(sf::Color color) const;     //!< returns count of nearest gamechips with provided color
 
         std::vector<StepField*> getCloseNeighbours() const;
 
-        std::vector<StepField*> getDistantNeighbours() const;
+        const std::vector<StepField*>& getDistantNeighbours() const;
 
         std::vector<StepField*> getFreeCloseNeighbours() const;
 
@@ -166,6 +201,8 @@ namespace Hexxagon
 
         StepField* selected_f = nullptr;    //!< current selected game board cell
 
+        StepField* hovered_f = nullptr;     //!< game board cell under mouse cursor
+
         GameStatus* progress = nullptr;    //!< containts game progress info
 
         bool AI_game = false;       //!< 'true' if user is playing with computer
@@ -174,19 +211,41 @@ namespace Hexxagon
 
         bool loaded = false;       //!< 'true' if game was loaded from save file
 
+        int autosave_steps = 0;        //!< steps between autosaves, 0 turns autosave off
+
+        int steps_since_save = 0;
+
+        std::function<void(Move, int)> step_listener;     //!< called after every step with the player, who made it
+
+        Position start_position;        //!< position, from which 'history' was played: new game or loaded save
+
+        std::vector<Move> history;      //!< steps of both players in order, for analysis
+
         HexxagonAI AI;
 
-        std::vector<std::vector<StepField*>> fields;
+        const Topology* topology;       //!< game board geometry, cells are stored in it's index order
+
+        Pool<StepField> cells;          //!< game board cells, one per topology cell
+        ChipPool chips;                 //!< storage of gamechips, one per occupied cell
+
+        std::vector<StepField*> fields;     //!< prebuilt list of game board cells in stable row-major order
+
+        mutable sf::VertexArray vertices{ sf::PrimitiveType::Triangles };      //!< cached geometry of all game board cells
 
         void draw(sf::RenderTarget& target, const sf::RenderStates& states) const override;
 
+        /// Returns game board cell in provided row and column
+        /// of the hexagon, or nullptr for holes and slots out of it.
+        ///
+        StepField* fieldAt(int row, int column) const;
+
         /// Basic steps logic, where is invoking
         /// doubleCheap() or moveCheap() methods.
         ///
         void makeStep(StepField* field);
 
         /// Initialization of every game board field 
-        /// to default value.
+        /// to default value, derived from the topology.
         ///
         void generateField();
 
@@ -198,7 +257,7 @@ namespace Hexxagon
         /// Creates new gamechip and moves in to provided
         /// field cell.
         ///
-        void doubleCheap(GameChip& chip, StepField* field);
+        void doubleCheap(const GameChip& chip, StepField* field);
 
         /// Moves provided gamechip from current field cell
         /// to another
@@ -214,10 +273,26 @@ namespace Hexxagon
         ///
         void clearSelected();
 
+        /// Returns gamechip's cell, from which the move is made:
+        /// any gamechip of the current player next to the target
+        /// for clones.
+        ///
+        StepField* sourceOf(Move move) const;
+
+        /// Converts point on display to the game board cell
+        /// in constant time: point is moved to fractional axial
+        /// coordinates of the layout from initFieldsLocation()
+        /// and rounded to the nearest hexagon.
+        ///
+        StepField* fieldAt(sf::Vector2f point) const;
+
     public:
-        Board(float fieldRadius, bool AI_game);
+        Board(float fieldRadius, bool AI_game, const Topology& topology = Topology::standard());
+
+        Board(float fieldRadius, std::string path, const Topology& topology = Topology::standard());
 
-        Board(float fieldRadius, std::string path);
+        Board(const Board&) = delete;
+        Board& operator=(const Board&) = delete;
 
         ~Board();
 
@@ -226,28 +301,108 @@ namespace Hexxagon
         ///
         void mousePressed(sf::RenderWindow& window);
 
+        /// Updates hovered game board cell.
+        ///
+        void mouseMoved(sf::RenderWindow& window);
+
+        /// Makes step of the engine move. Clones are made from
+        /// any gamechip of the current player next to the target.
+        ///
+        void play(Move move);
+
+        /// Selects source of the move, as if the player clicked
+        /// it, and outlines it's target in cyan, so one click
+        /// on the target makes the step.
+        ///
+        void showHint(Move move);
+
         /// Changes current player's number
         ///
         void nextPlayer();
 
-        /// Saving game board to provided file.
+        /// Saving game board to provided file. File is written
+        /// by IoWorker in background.
         ///
         void save(std::string file_name);
 
+        /// Returns save file contents of the game.
+        ///
+        std::string serialize() const;
+
+        /// Saves game every 'steps' steps of both players, to the
+        /// save file of loaded game or to "autosave". 0 turns it off.
+        ///
+        void setAutosave(int steps);
+
+        /// Sets strength of the computer player, index into
+        /// Difficulties.
+        ///
+        void setDifficulty(int level);
+
+        /// Sets function, which is called after every step of
+        /// either player, e.g. to send it over the network.
+        ///
+        void setStepListener(std::function<void(Move, int)> listener);
+
+        /// Shows provided position on the game board, e.g. to
+        /// step through analysed game. Removes all marks.
+        ///
+        void setState(const Position& position);
+
+        /// Outlines source and target cells of the move,
+        /// transparent color removes the marks.
+        ///
+        void markMove(Move move, const sf::Color& color);
+
         /// return a save file path
         ///
         std::string getSaveName() const;
 
         void setLocation(int x, int y);
 
+        /// Returns location of the cell in provided row and column
+        /// relatively to game board location: the layout, which
+        /// initFieldsLocation() uses, shared with thumbnails.
+        ///
+        static sf::Vector2f fieldLocation(const Topology& topology, float fieldRadius, int row, int column);
+
+        /// Returns largest cell radius, with which the layout of
+        /// fieldLocation() fits into square of provided size.
+        ///
+        static float fitFieldRadius(const Topology& topology, float size);
+
         /// Getters
         /// 
         GameStatus* getGameProgress() const;
 
-        std::vector<StepField*> getFields() const;
+        const std::vector<StepField*>& getFields() const;
+
+        const Topology& getTopology() const;
+
+        const HexxagonAI& getAI() const;
+
+        int getPlayer() const;      //!< returns player to move: 0 - red, 1 - blue
+
+        bool isComputerTurn() const;        //!< returns 'true' if computer is to move in game against it
+
+        /// Plays computer's step, once it's worker has chosen
+        /// it. Returns 'true' if the step was taken.
+        ///
+        bool playComputerStep();
+
+        const Position& getStartPosition() const;
+
+        const std::vector<Move>& getHistory() const;        //!< returns steps made since getStartPosition()
 
         bool wasLoaded() const;
 
+        bool isChanged() const;     //!< returns 'true' if any game board cell has to be redrawn
+
+        /// Returns headless copy of the game board
+        /// for the engine, with current player to move.
+        ///
+        Position toPosition() const;
+
         friend class HexxagonAI;
     };
 }
\ No newline at end of file
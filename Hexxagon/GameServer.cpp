@@ -0,0 +1,330 @@
+#include "GameServer.h"
+
+#ifdef __linux__
+#include <algorithm>
+#include <cerrno>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    GameServer::~GameServer()
+    {
+        ai.reset();     // workers notify through waker, so they stop first
+        for (int socket = 0; socket < (int)connections.size(); socket++)
+            if (connections[socket].open)
+                ::close(socket);
+        for (int fd : { listener, poller, waker })
+            if (fd >= 0)
+                ::close(fd);
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool GameServer::start(std::uint16_t port, bool loopback)
+    {
+        listener = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listener < 0)
+            return false;
+        int reuse = 1;
+        ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(loopback ? INADDR_LOOPBACK : INADDR_ANY);
+        if (::bind(listener, (sockaddr*)&address, sizeof(address)) < 0 || ::listen(listener, SOMAXCONN) < 0)
+            return false;
+        socklen_t length = sizeof(address);
+        ::getsockname(listener, (sockaddr*)&address, &length);
+        this->port = ntohs(address.sin_port);
+
+        poller = ::epoll_create1(EPOLL_CLOEXEC);
+        waker = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (poller < 0 || waker < 0)
+            return false;
+        for (int fd : { listener, waker }) {
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            ::epoll_ctl(poller, EPOLL_CTL_ADD, fd, &event);
+        }
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void GameServer::enableAi(const AiScheduler::Options& options)
+    {
+        ai = std::make_unique<AiScheduler>(options, [this] {
+            std::uint64_t one = 1;
+            [[maybe_unused]] auto written = ::write(waker, &one, sizeof(one));
+        });
+    }
+
+    ////////////////////////////////////////////////////////////
+    void GameServer::run()
+    {
+        epoll_event events[MaxEvents];
+        while (!stopping) {
+            int count = ::epoll_wait(poller, events, MaxEvents, -1);
+            for (int i = 0; i < count && !stopping; i++) {
+                const int fd = events[i].data.fd;
+                if (fd == listener)
+                    accept();
+                else if (fd == waker) {
+                    std::uint64_t count;
+                    [[maybe_unused]] auto read = ::read(waker, &count, sizeof(count));
+                    takeComputerSteps();
+                }
+                else {
+                    if (events[i].events & EPOLLOUT)
+                        flush(fd);
+                    if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+                        receive(fd);
+                }
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void GameServer::stop()
+    {
+        stopping = true;
+        std::uint64_t one = 1;
+        [[maybe_unused]] auto written = ::write(waker, &one, sizeof(one));
+    }
+
+    ////////////////////////////////////////////////////////////
+    void GameServer::accept()
+    {
+        while (true) {
+            int socket = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (socket < 0)
+                return;     // EAGAIN: no more pending clients
+            int no_delay = 1;
+            ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+
+            if (socket >= (int)connections.size())
+                connections.resize(socket + 1);
+            connections[socket] = Connection();
+            connections[socket].open = true;
+
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = socket;
+            ::epoll_ctl(poller, EPOLL_CTL_ADD, socket, &event);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void GameServer::receive(int socket)
+    {
+        while (connections[socket].open) {
+            Connection& connection = connections[socket];
+            ssize_t read = ::recv(socket, connection.input + connection.received, Message::Size - connection.received, 0);
+            if (read == 0 || (read < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                close(socket);
+                return;
+            }
+            if (read < 0)
+                return;
+
+            connection.received += (int)read;
+            if (connection.received == Message::Size) {
+                connection.received = 0;
+                std::optional<Message> message = Message::read(connection.input);
+                if (!message) {
+                    close(socket);
+                    return;
+                }
+                handle(socket, *message);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void GameServer::handle(int socket, const Message& message)
+    {
+        Connection& connection = connections[socket];
+        if (message.type == Message::Join) {
+            if (message.a != Message::Version || connection.game >= 0 || waiting == socket) {
+                close(socket);
+                return;
+            }
+            const bool computer = message.b != Message::Human;
+            if (computer && message.b - Message::ComputerLevel >= (int)Difficulties.size()) {
+                close(socket);
+                return;
+            }
+            if (computer && (!ai || ai->isSaturated())) {
+                send(socket, { Message::Busy });
+                return;
+            }
+            if (!computer && waiting < 0) {
+                waiting = socket;
+                return;
+            }
+
+            int game = (int)games.size();
+            if (!free_games.empty()) {
+                game = free_games.back();
+                free_games.pop_back();
+            }
+            else
+                games.emplace_back();
+            games[game].position = Position();
+            games[game].plies = 0;
+            games[game].players[Position::Red] = computer ? socket : waiting;
+            games[game].players[Position::Blue] = computer ? Computer : socket;
+            games[game].budget = computer ? ai->getOptions().budget_milliseconds : 0;
+            if (computer)
+                games[game].difficulty = message.b == Message::Computer ? ai->getOptions().difficulty : message.b - Message::ComputerLevel;
+            for (int side : { Position::Red, Position::Blue }) {
+                const int player = games[game].players[side];
+                if (player == Computer)
+                    continue;
+                connections[player].game = game;
+                connections[player].side = side;
+                send(player, { Message::Start, (std::uint8_t)side });
+            }
+            if (!computer)
+                waiting = -1;
+        }
+        else if (message.type == Message::Step && connection.game >= 0) {
+            Game& game = games[connection.game];
+            MoveList moves;
+            game.position.generateMoves(moves);
+            const Move move = message.getMove();
+            if (game.position.getSide() != connection.side || std::ranges::find(moves, move) == moves.end()) {
+                send(socket, { Message::Rejected, message.a, message.b });
+                return;
+            }
+
+            game.position.make(move);
+            game.plies++;
+            if (game.players[1 - connection.side] != Computer)
+                send(game.players[1 - connection.side], message);
+            finishStep(connection.game);
+        }
+        else
+            close(socket);      // no other messages come from clients
+    }
+
+    ////////////////////////////////////////////////////////////
+    void GameServer::finishStep(int index)
+    {
+        Game& game = games[index];
+        if (game.position.isGameOver() || game.plies >= MaxPlies) {
+            int margin = game.position.count(Position::Red) - game.position.count(Position::Blue);
+            Message over{ Message::GameOver, (std::uint8_t)(margin > 0 ? 0 : margin < 0 ? 1 : 2) };
+            for (int player : game.players)
+                if (player != Computer)
+                    send(player, over);
+            endGame(index);
+        }
+        else if (game.players[game.position.getSide()] == Computer) {
+            const int milliseconds = ai->getMoveTime(game.budget, game.position.getEmpty().count());
+            ai->submit({ index, game.generation, game.position, milliseconds, game.difficulty });
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void GameServer::takeComputerSteps()
+    {
+        if (!ai)
+            return;
+        for (const AiScheduler::Reply& reply : ai->takeReplies()) {
+            Game& game = games[reply.game];
+            if (game.generation != reply.generation)
+                continue;       // game has ended while computer was thinking
+            const int computer = game.position.getSide();
+            game.budget = std::max(0, game.budget - reply.milliseconds);
+            game.position.make(reply.move);
+            game.plies++;
+            send(game.players[1 - computer], Message::step(reply.move));
+            finishStep(reply.game);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void GameServer::send(int socket, const Message& message)
+    {
+        std::uint8_t bytes[Message::Size];
+        message.write(bytes);
+        connections[socket].output.append((const char*)bytes, Message::Size);
+        flush(socket);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void GameServer::flush(int socket)
+    {
+        Connection& connection = connections[socket];
+        while (!connection.output.empty()) {
+            ssize_t written = ::send(socket, connection.output.data(), connection.output.size(), MSG_NOSIGNAL);
+            if (written < 0)
+                break;
+            connection.output.erase(0, written);
+        }
+
+        const bool blocked = !connection.output.empty();
+        if (blocked != connection.watching_output) {
+            epoll_event event{};
+            event.events = EPOLLIN | (blocked ? (std::uint32_t)EPOLLOUT : 0u);
+            event.data.fd = socket;
+            ::epoll_ctl(poller, EPOLL_CTL_MOD, socket, &event);
+            connection.watching_output = blocked;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void GameServer::close(int socket)
+    {
+        Connection& connection = connections[socket];
+        if (waiting == socket)
+            waiting = -1;
+        if (connection.game >= 0) {
+            Game& game = games[connection.game];
+            int opponent = game.players[1 - connection.side];
+            endGame(connection.game);
+            if (opponent != Computer)
+                send(opponent, { Message::Left });
+        }
+        ::epoll_ctl(poller, EPOLL_CTL_DEL, socket, nullptr);
+        ::close(socket);
+        connection = Connection();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void GameServer::endGame(int game)
+    {
+        for (int& player : games[game].players) {
+            if (player != Computer)
+                connections[player].game = -1;
+            player = -1;
+        }
+        games[game].generation++;
+        free_games.push_back(game);
+    }
+}
+
+#else
+
+namespace Hexxagon
+{
+    GameServer::~GameServer() {}
+
+    bool GameServer::start(std::uint16_t, bool) { return false; }
+
+    void GameServer::enableAi(const AiScheduler::Options&) {}
+
+    void GameServer::run() {}
+
+    void GameServer::stop() {}
+}
+
+#endif
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AiScheduler.h"
+#include "Protocol.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    /// Authoritative server of two-player network games. Clients
+    /// are paired in order of joining, every step is checked with
+    /// Position rules before it is relayed to the opponent.
+    ///
+    /// All games are served by one thread on epoll (Linux only;
+    /// elsewhere start() fails). Game keeps only its Position and
+    /// two sockets, connection - a partial message and unsent bytes.
+    ///
+    /// With enableAi() clients may play against computer: its
+    /// steps are chosen by the shared AiScheduler and come back
+    /// to the epoll thread through the same eventfd, which stop() uses.
+    ////////////////////////////////////////////////////////////
+    class GameServer
+    {
+    public:
+#ifdef __linux__
+        static constexpr bool Supported = true;
+#else
+        static constexpr bool Supported = false;        //!< epoll is Linux only
+#endif
+        static constexpr int MaxEvents = 256;       //!< events taken from epoll at once
+        static constexpr int Computer = -2;     //!< player socket of computer side
+        static constexpr int MaxPlies = 400;        //!< longer games are adjudicated by piece count, jumps can go around forever
+
+    private:
+        struct Game
+        {
+            Position position;
+            int players[2] = { -1, -1 };        //!< sockets of red and blue, -1 when game is free
+            std::uint32_t generation = 0;       //!< incremented when game ends, so late computer steps are dropped
+            int budget = 0;     //!< search time left to computer, ms
+            int difficulty = 0;     //!< of the computer
+            int plies = 0;
+        };
+
+        struct Connection
+        {
+            int game = -1;
+            int side = Position::Red;
+            std::uint8_t input[Message::Size];
+            int received = 0;       //!< bytes of the input message
+            std::string output;     //!< bytes, which socket didn't take yet
+            bool watching_output = false;       //!< 'true' while epoll reports writability
+            bool open = false;
+        };
+
+        int listener = -1;
+        int poller = -1;        //!< epoll instance
+        int waker = -1;     //!< eventfd, which breaks run() out of waiting on stop()
+        std::uint16_t port = 0;
+        std::atomic<bool> stopping = false;
+
+        std::vector<Connection> connections;        //!< indexed by socket
+        std::vector<Game> games;
+        std::vector<int> free_games;        //!< indices of finished games for reuse
+        int waiting = -1;       //!< socket of client without opponent
+
+        std::unique_ptr<AiScheduler> ai;
+
+        void accept();
+
+        void receive(int socket);
+
+        void handle(int socket, const Message& message);
+
+        void send(int socket, const Message& message);
+
+        void flush(int socket);     //!< writes unsent bytes, watching for writability while some are left
+
+        void close(int socket);
+
+        void endGame(int game);
+
+        void finishStep(int game);      //!< reports end of game or asks computer for the next step
+
+        void takeComputerSteps();
+
+    public:
+        GameServer() {};
+
+        GameServer(const GameServer&) = delete;
+        GameServer& operator=(const GameServer&) = delete;
+
+        ~GameServer();
+
+        /// Opens listening socket. Port 0 takes any free port,
+        /// getPort() returns it. 'loopback' limits clients to
+        /// this machine. Returns 'false' on failure.
+        ///
+        bool start(std::uint16_t port, bool loopback = false);
+
+        /// Allows games against computer. Has to be called
+        /// after start().
+        ///
+        void enableAi(const AiScheduler::Options& options);
+
+        /// Serves clients until stop() is called.
+        ///
+        void run();
+
+        void stop();        //!< may be called from any thread
+
+        std::uint16_t getPort() const { return port; }
+    };
+}
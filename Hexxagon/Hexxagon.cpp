@@ -11,138 +11,17 @@ namespace sf {
 	};
 }
 
-/// Class for recording game info
-/// into file.
-/// 
-class ScoreRec : public sf::Text {
-private:
-	string nickname;
-	int score;
-	int points;
-	string time;
-
-	void verify() {
-		if (score < 0)
-			score = 0;
-		if (points < 0)
-			points = 0;
-	}
-public:
-	ScoreRec(string input, sf::Font& font) : sf::Text(font, "", 50) {
-		auto str_input = stringstream(input);
-		getline(str_input, nickname, '_');
-		string buff;
-		getline(str_input, buff, ';');
-		score = stoi(buff);
-		getline(str_input, buff, '|');
-		points = stoi(buff);
-		str_input >> time;
-		verify();
-
-		setString(nickname + " - " + std::to_string(score) + " (" + std::to_string(points) + " points) " + time);
-	}
-
-	ScoreRec(Hexxagon::Board::GameStatus* status, sf::Font& font) : sf::Text(font, "", 50)
-	{
-		bool red_won = status->getRedPoints() > status->getBluePoints();
-		if (red_won) {
-			nickname = "Red";
-			score = status->getRedScore();
-			points = status->getRedPoints();
-		}
-		else {
-			nickname = "Blue";
-			score = status->getBlueScore();
-			points = status->getBluePoints();
-		}
-		time = status->getTime();
-
-		verify();
-		setString(nickname + " - " + std::to_string(score) + " (" + std::to_string(points) + ")");
-	}
-
-	/// Basic file read logic, which returns
-	/// vector of saved scores info.
-	///
-	static vector<ScoreRec> read_file(std::fstream& stream, sf::Font& font) {
-		vector<ScoreRec> v;
-		string buff;
-		while (std::getline(stream, buff)) {
-			v.emplace_back(buff, font);
-		}
-		return v;
-	};
-
-	/// Basic file write logic, which writes info
-	/// from vector of ScoreRec objects.
-	///
-	static void write_file(vector<ScoreRec> v, string file_path) {
-		fstream stream(file_path, ios::out | ios::trunc);
-		for (ScoreRec elem : v) {
-			stream << elem << '\n';
-		}
-		stream.close();
-	};
-
-	/// Score table sorting.
-	///
-	static void sort(vector<ScoreRec>& v) {
-		if (v.size() > 0) {
-			for (int i = 0; i < v.size(); i++) {
-				for (int j = i + 1; j < v.size(); j++) {
-					if (v[i] < v[j]) {
-						ScoreRec buff = v[i];
-						v[i] = v[j];
-						v[j] = buff;
-					}
-				}
-			}
-		}
-	}
-
-	/// Getters
-	///
-	string getNickname() const {
-		return nickname;
-	}
-
-	int getScore() const {
-		return score;
-	}
-
-	int getPoints() const {
-		return points;
-	}
-
-	/// Operators
-	///
-	friend std::ostream& operator <<(std::fstream& fstream, const ScoreRec& score_obj) {
-		return fstream << score_obj.nickname << "_" << score_obj.score << ';' << score_obj.points << "|" << score_obj.time;
-	}
-	friend std::ostream& operator <<(std::ostream& fstream, const ScoreRec& score_obj) {
-		return fstream << score_obj.nickname << "_" << score_obj.score << ';' << score_obj.points << "|" << score_obj.time;
-	}
-
-	friend bool operator <(ScoreRec& score_1, ScoreRec& score_2) {
-		return score_1.score < score_2.score;
-	}
-
-	friend bool operator >(ScoreRec& score_1, ScoreRec& score_2) {
-		return score_1.score > score_2.score;
-	}
-};
-
 ///////////////////////////////////////////////////
 /// High score panel rendering function.
 ///////////////////////////////////////////////////
 void highScorePanelRender(sf::RenderWindow& window) {
+	Hexxagon::IoWorker::instance().flush();
 	auto file_stream = std::fstream(
 		"Saves\\scores.txt",
 		std::ios::in
 	);
 
-	sf::Font font;
-	font.loadFromFile("Assets\\BradBunR.ttf");
+	const sf::Font& font = sf::AssetRegistry::instance().font("Assets\\BradBunR.ttf");
 	vector<ScoreRec> scores = ScoreRec::read_file(file_stream, font);
 	file_stream.close();
 
@@ -154,10 +33,10 @@ void highScorePanelRender(sf::RenderWindow& window) {
 		y_shift += score.getLocalBounds().getSize().y + 20.f;
 	}
 	sf::Event event;
+	sf::FramePacer pacer(window);
 
 	while (window.isOpen()) {
-		window.clear();
-		while (window.pollEvent(event)) {
+		while (pacer.pollEvent(event)) {
 			if (event.type == sf::Event::Closed) {
 				window.close();
 			}
@@ -165,29 +44,233 @@ void highScorePanelRender(sf::RenderWindow& window) {
 				return;
 			}
 		}
-		for (ScoreRec& score : scores) {
-			window.draw(score);
-		}
 
-		window.display();
+		if (pacer.needsRedraw()) {
+			window.clear();
+			for (ScoreRec& score : scores) {
+				window.draw(score);
+			}
+			pacer.display();
+		}
 	}
 }
 
 void menuRender(sf::RenderWindow& window);
 
+std::optional<Hexxagon::Topology> custom_topology;		// board loaded with '--board' option
+const Hexxagon::Topology* board_topology = &Hexxagon::Topology::standard();		// geometry of new games
+bool saves_enabled = true;		// save files keep standard board only, so '--board' turns saving and loading off
+int autosave_steps = 10;		// steps between autosaves, '--autosave 0' turns them off
+int spectated_games = 0;		// games shown by '--spectate N' instead of the menu
+bool net_hosting = false;		// '--host PORT' runs loopback server and joins it
+string net_host;		// '--connect HOST:PORT' joins the server
+std::uint16_t net_port = 0;
+bool net_computer = false;		// '--server-ai' asks the server for a computer opponent
+int ai_level = Hexxagon::DefaultDifficulty;		// difficulty of the computer, '--level N' or chosen in the menu
+
+///////////////////////////////////////////////////
+/// Text of the search statistics overlay.
+///////////////////////////////////////////////////
+std::string formatStats(const Hexxagon::HexxagonAI& AI) {
+	const Hexxagon::SearchStats& stats = AI.getStats();
+	std::ostringstream text;
+	text << "move: " << (*AI.getSource() ? AI.getSource() : "-") << "\n"
+		<< "depth: " << stats.depth << "\n"
+		<< "score: " << stats.score << "\n"
+		<< "nodes: " << stats.nodes << "\n"
+		<< "nps: " << stats.getNodesPerSecond() << "\n"
+		<< std::fixed << std::setprecision(1)
+		<< "tt hits: " << stats.getTableHitRate() * 100 << "%\n"
+		<< "first cut: " << stats.getFirstMoveCutoffRate() * 100 << "%\n"
+		<< "pv:";
+	for (const Hexxagon::Move& move : stats.pv)
+		text << " " << (int)move.from << ":" << (int)move.to;
+	return text.str();
+}
+
+///////////////////////////////////////////////////
+/// Score of the engine in gamechips, proven results
+/// as the final margin.
+///////////////////////////////////////////////////
+std::string formatScore(int score) {
+	std::ostringstream text;
+	if (score >= Hexxagon::WinScore)
+		text << "win +" << score - Hexxagon::WinScore;
+	else if (score <= -Hexxagon::WinScore)
+		text << "loss " << score + Hexxagon::WinScore;
+	else
+		text << std::showpos << std::fixed << std::setprecision(1) << score / 100.f;
+	return text.str();
+}
+
+///////////////////////////////////////////////////
+/// Analysis panel of a finished game. The engine
+/// searches every step on all cores; Left and Right
+/// walk through the game with the played step
+/// outlined in white and the engine's best one in
+/// green, Up and Down jump between mistakes. The
+/// graph shows evaluation from red's view.
+///////////////////////////////////////////////////
+void analysisRender(sf::RenderWindow& window, const Hexxagon::Position& start, const std::vector<Hexxagon::Move>& moves) {
+	if (moves.empty())
+		return;
+
+	static constexpr const char* MarkNames[] = { "", "Inaccuracy", "Mistake", "Blunder" };
+	static const sf::Color MarkColors[] = { sf::Color::White, sf::Color::Yellow, sf::Color(255, 103, 0), sf::Color::Red };
+	static constexpr int GraphRange = 1000;		// scores beyond 10 gamechips are drawn at the edge
+
+	sf::Event event;
+	Hexxagon::GameAnalysis analysis(start, moves, 500);
+	const Hexxagon::Topology& topology = start.getTopology();
+	Hexxagon::Board board(35.f * 4 / topology.radius(), false, topology);
+	board.setLocation(window.getSize().x / 2, window.getSize().y / 2 - 60);
+
+	const sf::Font& font = sf::AssetRegistry::instance().font("Assets\\BradBunR.ttf");
+	sf::Text step_text(font, "", 30);
+	step_text.setPosition({ 20.f, 10.f });
+	sf::Text summary_text(font, "", 24);
+	summary_text.setFillColor(sf::Color(200, 200, 200));
+
+	const sf::FloatRect graph({ 40.f, window.getSize().y - 150.f }, { window.getSize().x - 80.f, 120.f });
+	sf::VertexArray graph_line(sf::PrimitiveType::LineStrip);
+	sf::RectangleShape graph_axis({ graph.size.x, 1.f });
+	graph_axis.setPosition({ graph.position.x, graph.position.y + graph.size.y / 2.f });
+	graph_axis.setFillColor(sf::Color(90, 90, 90));
+	sf::RectangleShape graph_cursor({ 2.f, graph.size.y });
+	graph_cursor.setFillColor(sf::Color(0, 71, 171));
+	auto graphX = [&](int step) { return graph.position.x + graph.size.x * (step + 1) / analysis.size(); };
+
+	int step = 0;
+	int completed = -1;
+	auto show = [&]() {
+		board.setState(analysis.getPosition(step));
+		std::ostringstream text;
+		step_text.setFillColor(sf::Color::White);
+		if (step == analysis.size())
+			text << "Final position";
+		else if (!analysis.isReady(step)) {
+			text << "Step " << step + 1 << " of " << analysis.size() << "\nanalysing...";
+			board.markMove(moves[step], sf::Color::White);
+		}
+		else {
+			Hexxagon::AnalyzedStep analyzed = analysis.get(step);
+			board.markMove(analyzed.best, sf::Color::Green);
+			board.markMove(analyzed.played, sf::Color::White);
+			text << "Step " << step + 1 << " of " << analysis.size() << (analyzed.side == Hexxagon::Position::Red ? ", red" : ", blue")
+				<< "\nplayed " << (int)analyzed.played.from << ":" << (int)analyzed.played.to << "  " << formatScore(analyzed.played_score);
+			if (analyzed.played != analyzed.best)
+				text << "\nbest " << (int)analyzed.best.from << ":" << (int)analyzed.best.to << "  " << formatScore(analyzed.best_score);
+			text << "\n" << MarkNames[analyzed.mark];
+			step_text.setFillColor(MarkColors[analyzed.mark]);
+		}
+		step_text.setString(text.str());
+		graph_cursor.setPosition({ graphX(step) - 1.f, graph.position.y });
+	};
+	auto jump = [&](int direction) {
+		for (int i = step + direction; i >= 0 && i < analysis.size() && analysis.isReady(i); i += direction) {
+			if (analysis.get(i).mark >= Hexxagon::AnalyzedStep::Mistake) {
+				step = i;
+				return;
+			}
+		}
+	};
+
+	sf::FramePacer pacer(window);
+	while (window.isOpen()) {
+		while (pacer.pollEvent(event)) {
+			if (event.type == sf::Event::Closed)
+				window.close();
+			else if (event.type == sf::Event::KeyPressed) {
+				if (event.key.code == sf::Keyboard::Escape)
+					return;
+				else if (event.key.code == sf::Keyboard::Left)
+					step = std::max(step - 1, 0);
+				else if (event.key.code == sf::Keyboard::Right)
+					step = std::min(step + 1, analysis.size());
+				else if (event.key.code == sf::Keyboard::Home)
+					step = 0;
+				else if (event.key.code == sf::Keyboard::End)
+					step = analysis.size();
+				else if (event.key.code == sf::Keyboard::Up)
+					jump(-1);
+				else if (event.key.code == sf::Keyboard::Down)
+					jump(1);
+				show();
+				pacer.invalidate();
+			}
+		}
+
+		if (analysis.getCompleted() != completed) {
+			completed = analysis.getCompleted();
+			graph_line.clear();
+			int marks[2][4] = {};
+			for (int i = 0; i < analysis.size() && analysis.isReady(i); i++) {
+				Hexxagon::AnalyzedStep analyzed = analysis.get(i);
+				marks[analyzed.side][analyzed.mark]++;
+				float score = (float)std::clamp(analyzed.red_score, -GraphRange, GraphRange) / GraphRange;
+				graph_line.append(sf::Vertex{ { graphX(i), graph.position.y + graph.size.y * (0.5f - score / 2.f) }, MarkColors[analyzed.mark] });
+			}
+			std::ostringstream text;
+			if (!analysis.isFinished())
+				text << "Analysing " << completed << "/" << analysis.size() << "\n";
+			for (int side : { Hexxagon::Position::Red, Hexxagon::Position::Blue })
+				text << (side == Hexxagon::Position::Red ? "Red: " : "Blue: ") << marks[side][Hexxagon::AnalyzedStep::Inaccuracy] << " inaccuracies, "
+					<< marks[side][Hexxagon::AnalyzedStep::Mistake] << " mistakes, " << marks[side][Hexxagon::AnalyzedStep::Blunder] << " blunders\n";
+			summary_text.setString(text.str());
+			summary_text.setPosition({ window.getSize().x - summary_text.getLocalBounds().getSize().x - 20.f, 10.f });
+			show();
+			pacer.invalidate();
+		}
+		if (!analysis.isFinished())
+			pacer.keepPolling();		// finished searches don't wake window event queue
+
+		if (pacer.needsRedraw()) {
+			window.clear();
+			window.draw(board);
+			window.draw(graph_axis);
+			window.draw(graph_line);
+			window.draw(graph_cursor);
+			window.draw(step_text);
+			window.draw(summary_text);
+			pacer.display();
+		}
+	}
+}
+
+///////////////////////////////////////////////////
+/// Engine of in-game hints, which keeps searched
+/// positions for the whole session.
+///////////////////////////////////////////////////
+Hexxagon::HintEngine& hintEngine() {
+	static Hexxagon::HintEngine engine(Hexxagon::HexxagonAI::getWeights(), Hexxagon::HexxagonAI::getNetwork());
+	return engine;
+}
+
 ///////////////////////////////////////////////////
 /// Game panel rendering function.
 ///////////////////////////////////////////////////
-void gameRender(sf::RenderWindow& window, bool playWithAI = false, string path = "") {
+void gameRender(sf::RenderWindow& window, bool playWithAI = false, string path = "", Hexxagon::NetClient* net = nullptr, int net_side = 0) {
 	sf::Event event;
-	Hexxagon::Board* board;
+	std::unique_ptr<Hexxagon::Board> board;
 	if(path.length() > 0)
-		board = new Hexxagon::Board(35, path);
+		board = std::make_unique<Hexxagon::Board>(35, path);
 	else
-		board = new Hexxagon::Board(35, playWithAI);
+		board = std::make_unique<Hexxagon::Board>(35.f * 4 / board_topology->radius(), playWithAI, *board_topology);
 
 	board->getGameProgress()->calculateProgress();
 	board->setLocation(window.getSize().x / 2, window.getSize().y / 2);
+	const bool saved = net == nullptr && saves_enabled;
+	board->setAutosave(saved ? autosave_steps : 0);
+	board->setDifficulty(ai_level);
+	board->setStepListener([net, net_side](Hexxagon::Move move, int player) {
+		hintEngine().cancel();		// pondered position is gone, computer's step gets the core
+		if (net != nullptr && player == net_side)
+			net->send(Hexxagon::Message::step(move));
+	});
+	auto humans_turn = [&] { return net != nullptr ? net->isConnected() && board->getPlayer() == net_side : !board->isComputerTurn(); };
+	std::size_t pondered_steps = -1;		// history size, at which pondering was last switched
+	bool hint_pending = false;		// 'H' was pressed, but the position isn't searched yet
+	bool hints_used = false;		// pondering starts with the first hint, so games without hints don't pay for it
 
 	int red_rect_width;
 	int blue_rect_width;
@@ -199,8 +282,7 @@ void gameRender(sf::RenderWindow& window, bool playWithAI = false, string path =
 	blue_rect.setPosition({ 0.f, window.getSize().y / 2.f + 25 });
 	blue_rect.setFillColor(sf::Color::Blue);
 
-	sf::Font font;
-	font.loadFromFile("Assets\\BradBunR.ttf");
+	const sf::Font& font = sf::AssetRegistry::instance().font("Assets\\BradBunR.ttf");
 	sf::Text rp_count(font, "3", 30);
 	rp_count.setPosition({ 20.f, red_rect.getPosition().y });
 	sf::Text bp_count(font, "3", 30);
@@ -211,10 +293,17 @@ void gameRender(sf::RenderWindow& window, bool playWithAI = false, string path =
 	sf::Text blue_score(font, "Score: 0", 50);
 	blue_score.setPosition({ 20.f, window.getSize().y - 70.f });
 
+	sf::Text net_text(font, "", 40);		// whose turn it is in network game
+	net_text.setPosition({ window.getSize().x - 350.f, 10.f });
+
+	sf::Text analysis_hint(font, "A - analyse the game", 30);
+	analysis_hint.setPosition({ window.getSize().x / 2.f - analysis_hint.getLocalBounds().getSize().x / 2.f, window.getSize().y - 120.f });
+
 	sf::Text final_text(font, "", 250);
 	final_text.setOutlineColor(sf::Color(255, 103, 0));
 	final_text.setOutlineThickness(5);
 
+	Hexxagon::IoWorker::instance().flush();
 	auto file_stream = std::fstream(
 		"Saves\\scores.txt",
 		std::ios::in
@@ -224,7 +313,6 @@ void gameRender(sf::RenderWindow& window, bool playWithAI = false, string path =
 
 	ScoreRec::sort(scores);
 
-	font.loadFromFile("Assets\\BradBunR.ttf");
 	sf::TextField text_field({350.f, 50.f}, font, sf::Color::White, 40, 4, sf::Color::White);
 	text_field.setFillColor(sf::Color::Black);
 	text_field.setPosition({ window.getSize().x / 2.f - text_field.getSize().x / 2.f, window.getSize().y / 2.f - text_field.getSize().y / 2.f });
@@ -235,17 +323,37 @@ void gameRender(sf::RenderWindow& window, bool playWithAI = false, string path =
 
 	bool score_updated = false;
 	bool text_field_opened = false;
+
+	bool stats_shown = false;		// F3 toggles statistics of the computer's last step
+	sf::Text stats_text(font, "", 22);
+	stats_text.setFillColor(sf::Color(200, 200, 200));
+
+	sf::Profiler& profiler = sf::Profiler::instance();
+	static const int events_section = profiler.section("events");
+	static const int scores_section = profiler.section("scores");
+	static const int draw_section = profiler.section("draw");
+	bool profiler_shown = false;		// F2 toggles frame timings, F12 writes them to file
+	sf::ProfilerOverlay profiler_overlay(profiler, sf::AssetRegistry::instance().font("Assets\\BradBunR.ttf"));
+	profiler_overlay.setPosition({ window.getSize().x - sf::Profiler::FrameCount - 220.f, window.getSize().y - 330.f });
+
+	sf::FramePacer pacer(window);
 	while (window.isOpen()) {
-		window.clear();
-		while (window.pollEvent(event)) {
+		while (pacer.pollEvent(event)) {
+			sf::ProfileScope events_scope(events_section);
 			if (event.type == sf::Event::Closed) {
 				window.close();
 			}
-			else if (event.type == sf::Event::MouseButtonPressed || event.type == sf::Event::MouseEntered) {
+			else if ((event.type == sf::Event::MouseButtonPressed || event.type == sf::Event::MouseEntered) && humans_turn()) {
 				board->mousePressed(window);
 			}
+			else if (event.type == sf::Event::MouseMoved && !text_field_opened) {
+				board->mouseMoved(window);
+			}
 			else if (event.type == sf::Event::KeyPressed) {
+				pacer.invalidate();
 				if (event.key.code == sf::Keyboard::Escape) {
+					if (!saved)
+						return;		// network games and games on variant boards are not saved
 					if (board->getGameProgress()->isRunning()) {
 						if (text_field_opened) {
 							text_field_opened = false;
@@ -265,78 +373,155 @@ void gameRender(sf::RenderWindow& window, bool playWithAI = false, string path =
 					board->save(text_field.getText());
 					return;
 				}
+				else if (event.key.code == sf::Keyboard::H && !text_field_opened && board->getGameProgress()->isRunning() && humans_turn())
+					hint_pending = hints_used = true;
+				else if (event.key.code == sf::Keyboard::A && !board->getGameProgress()->isRunning())
+					analysisRender(window, board->getStartPosition(), board->getHistory());
+				else if (event.key.code == sf::Keyboard::F3 && playWithAI)
+					stats_shown = !stats_shown;
+				else if (event.key.code == sf::Keyboard::F2)
+					profiler_shown = !profiler_shown;
+				else if (event.key.code == sf::Keyboard::F12)
+					profiler.dump("Saves\\profile.csv");
 			}
 
-			if (board->getGameProgress()->isChanged()) {
-				int rp = board->getGameProgress()->getRedPoints();
-				int bp = board->getGameProgress()->getBluePoints();
-				red_rect_width = rp * 2;
-				blue_rect_width = bp * 2;
+			if(text_field_opened)
+				text_field.handleEvent(window, event);
+		}
+
+		if (net != nullptr) {
+			while (std::optional<Hexxagon::Message> message = net->receive()) {
+				if (message->type == Hexxagon::Message::Step)
+					board->play(message->getMove());
+				else if (message->type == Hexxagon::Message::Left || message->type == Hexxagon::Message::Rejected) {
+					net_text.setString(message->type == Hexxagon::Message::Left ? "Opponent left" : "Out of sync");
+					net->disconnect();
+				}
+				else if (message->type == Hexxagon::Message::GameOver) {		// also sent, when server stops too long game
+					static constexpr const char* Results[] = { "Red won", "Blue won", "Draw" };
+					net_text.setString(message->a < 3 ? Results[message->a] : "Game over");
+					net->disconnect();
+				}
+				pacer.invalidate();
+			}
+			if (net->isConnected()) {
+				net_text.setString(board->getPlayer() == net_side ? "Your turn" : "Opponent's turn");
+				pacer.keepPolling();		// opponent's steps don't wake window event queue
+			}
+		}
 
-				red_rect.setSize({ (float)red_rect_width , 50.f });
-				blue_rect.setSize({ (float)blue_rect_width , 50.f });
+		if (board->playComputerStep())
+			pacer.invalidate();
+		else if (board->getAI().isThinking())
+			pacer.keepPolling();		// computer's step doesn't wake window event queue
 
-				rp_count.setString(std::to_string(rp));
-				bp_count.setString(std::to_string(bp));
+		if (board->getGameProgress()->isChanged()) {
+			int rp = board->getGameProgress()->getRedPoints();
+			int bp = board->getGameProgress()->getBluePoints();
+			red_rect_width = rp * 2;
+			blue_rect_width = bp * 2;
 
-				red_score.setString("Score: " + std::to_string(board->getGameProgress()->getRedScore()));
-				blue_score.setString("Score: " + std::to_string(board->getGameProgress()->getBlueScore()));
+			red_rect.setSize({ (float)red_rect_width , 50.f });
+			blue_rect.setSize({ (float)blue_rect_width , 50.f });
 
-				if (!board->getGameProgress()->isRunning()) {
-					if (!score_updated) {
-						if (rp > bp) {
-							final_text.setString("Reds Won!");
-							final_text.setFillColor(sf::Color(227, 38, 54));
-						}
-						else if (rp < bp) {
-							final_text.setString("Blue Won!");
-							final_text.setFillColor(sf::Color(0, 71, 171));
-						}
-						else {
-							final_text.setString("Draw!");
-							final_text.setFillColor(sf::Color::White);
-						}
-						final_text.setPosition({
-							window.getSize().x / 2.f - final_text.getLocalBounds().getSize().x / 2.f,
-							window.getSize().y / 2.f - 180.f });
+			rp_count.setString(std::to_string(rp));
+			bp_count.setString(std::to_string(bp));
+
+			red_score.setString("Score: " + std::to_string(board->getGameProgress()->getRedScore()));
+			blue_score.setString("Score: " + std::to_string(board->getGameProgress()->getBlueScore()));
+
+			if (!board->getGameProgress()->isRunning()) {
+				if (!score_updated) {
+					if (rp > bp) {
+						final_text.setString("Reds Won!");
+						final_text.setFillColor(sf::Color(227, 38, 54));
+					}
+					else if (rp < bp) {
+						final_text.setString("Blue Won!");
+						final_text.setFillColor(sf::Color(0, 71, 171));
+					}
+					else {
+						final_text.setString("Draw!");
+						final_text.setFillColor(sf::Color::White);
 					}
+					final_text.setPosition({
+						window.getSize().x / 2.f - final_text.getLocalBounds().getSize().x / 2.f,
+						window.getSize().y / 2.f - 180.f });
 				}
 			}
-
-			if(text_field_opened)
-				text_field.handleEvent(window, event);
 		}
 
-		if (text_field_opened) {
-			window.draw(text_field);
-			window.draw(text_title);
+		if (board->getHistory().size() != pondered_steps) {
+			pondered_steps = board->getHistory().size();
+			hint_pending = false;
+			if (hints_used && board->getGameProgress()->isRunning() && humans_turn())
+				hintEngine().ponder(board->toPosition());
+			else
+				hintEngine().cancel();
 		}
-		else {
-			window.draw(*board);
-			window.draw(red_rect);
-			window.draw(blue_rect);
-			window.draw(rp_count);
-			window.draw(bp_count);
-			window.draw(red_score);
-			window.draw(blue_score);
+		if (hint_pending) {
+			const Hexxagon::Position position = board->toPosition();
+			if (std::optional<Hexxagon::HintEngine::Hint> hint = hintEngine().probe(position)) {
+				board->showHint(hint->move);
+				hint_pending = false;
+			}
+			else {
+				hintEngine().ponder(position);
+				pacer.keepPolling();		// search doesn't wake window event queue
+			}
 		}
 
-		if (!board->getGameProgress()->isRunning()) {
-			if (!score_updated) {
-				score_updated = true;
-				ScoreRec score(board->getGameProgress(), font);
-				if (scores.size() > 4) {
-					if (scores[scores.size() - 1] < score)
-						scores[scores.size() - 1] = score;
-				}
-				else
-					scores.push_back(score);
-				ScoreRec::write_file(scores, "Saves\\scores.txt");
+		if ((!text_field_opened && board->isChanged()) || text_field.wasChanged())
+			pacer.invalidate();
+
+		if (!board->getGameProgress()->isRunning() && !score_updated) {
+			score_updated = true;
+			ScoreRec score(board->getGameProgress(), font);
+			if (scores.size() > 4) {
+				if (scores[scores.size() - 1] < score)
+					scores[scores.size() - 1] = score;
 			}
-			window.draw(final_text);
+			else
+				scores.push_back(score);
+			sf::ProfileScope scores_scope(scores_section);
+			ScoreRec::write_file(scores, "Saves\\scores.txt");
+			pacer.invalidate();
 		}
 
-		window.display();
+		if (pacer.needsRedraw()) {
+			sf::ProfileScope draw_scope(draw_section);
+			window.clear();
+			if (text_field_opened) {
+				window.draw(text_field);
+				window.draw(text_title);
+			}
+			else {
+				window.draw(*board);
+				window.draw(red_rect);
+				window.draw(blue_rect);
+				window.draw(rp_count);
+				window.draw(bp_count);
+				window.draw(red_score);
+				window.draw(blue_score);
+				if (net != nullptr)
+					window.draw(net_text);
+				if (stats_shown) {
+					stats_text.setString(formatStats(board->getAI()));
+					stats_text.setPosition({ window.getSize().x - stats_text.getLocalBounds().getSize().x - 20.f, 10.f });
+					window.draw(stats_text);
+				}
+			}
+
+			if (!board->getGameProgress()->isRunning()) {
+				window.draw(final_text);
+				if (!board->getHistory().empty())
+					window.draw(analysis_hint);
+			}
+			if (profiler_shown)
+				window.draw(profiler_overlay);
+
+			pacer.display();
+		}
 	}
 }
 
@@ -344,6 +529,122 @@ void gameRender(sf::RenderWindow& window, string path) {
 	gameRender(window, false, path);
 }
 
+///////////////////////////////////////////////////
+/// Network game: waits for opponent on the server
+/// and plays on the standard board. With '--host'
+/// the server runs in this process on loopback.
+///////////////////////////////////////////////////
+void networkRender(sf::RenderWindow& window) {
+	Hexxagon::GameServer server;
+	std::thread server_thread;
+	string host = net_host;
+	std::uint16_t port = net_port;
+	if (net_hosting) {
+		if (!server.start(net_port, true)) {
+			std::cout << "Could not listen on port " << net_port << "\n";
+			return;
+		}
+		if (net_computer)
+			server.enableAi({});
+		server_thread = std::thread(&Hexxagon::GameServer::run, &server);
+		host = "127.0.0.1";
+		port = server.getPort();
+	}
+
+	Hexxagon::NetClient client;
+	if (client.connect(host, port, net_computer ? Hexxagon::Message::ComputerLevel + ai_level : Hexxagon::Message::Human)) {
+		sf::Event event;
+		const sf::Font& font = sf::AssetRegistry::instance().font("Assets\\BradBunR.ttf");
+		sf::Text waiting_text(font, "Waiting for opponent on " + host + ":" + std::to_string(port), 40);
+		waiting_text.setPosition({ window.getSize().x / 2.f - waiting_text.getLocalBounds().getSize().x / 2.f, window.getSize().y / 2.f - 20.f });
+
+		sf::FramePacer pacer(window);
+		bool waiting = true;
+		while (waiting && window.isOpen()) {
+			while (pacer.pollEvent(event)) {
+				if (event.type == sf::Event::Closed)
+					window.close();
+				else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)
+					waiting = false;
+			}
+			while (std::optional<Hexxagon::Message> message = client.receive()) {
+				if (message->type == Hexxagon::Message::Busy || message->type == Hexxagon::Message::Left) {
+					waiting_text.setString(message->type == Hexxagon::Message::Busy ? "Server is busy, try later" : "Server has closed connection");
+					client.disconnect();
+				}
+				else if (message->type == Hexxagon::Message::Start) {
+					const Hexxagon::Topology* local_topology = board_topology;
+					board_topology = &Hexxagon::Topology::standard();		// server plays standard board only
+					gameRender(window, false, "", &client, message->a);
+					board_topology = local_topology;
+					waiting = false;
+					break;
+				}
+				pacer.invalidate();
+			}
+			if (client.isConnected())
+				pacer.keepPolling();		// server messages don't wake window event queue
+			if (waiting && pacer.needsRedraw()) {
+				window.clear();
+				window.draw(waiting_text);
+				pacer.display();
+			}
+		}
+	}
+	else
+		std::cout << "Could not connect to " << host << ":" << port << "\n";
+
+	client.disconnect();
+	if (net_hosting) {
+		server.stop();
+		server_thread.join();
+	}
+}
+
+///////////////////////////////////////////////////
+/// Spectator mode rendering function: grid of
+/// engine games played in background.
+///////////////////////////////////////////////////
+void spectatorRender(sf::RenderWindow& window, int games) {
+	sf::Event event;
+	const unsigned int cores = std::max(1u, std::thread::hardware_concurrency());		// 0 if unknown
+	Hexxagon::MatchRunner runner(games, std::max(1u, cores - 1), 100, *board_topology);
+	sf::SpectatorGrid grid(runner, sf::AssetRegistry::instance().font("Assets\\BradBunR.ttf"), { (float)window.getSize().x, (float)window.getSize().y });
+
+	sf::Profiler& profiler = sf::Profiler::instance();
+	static const int draw_section = profiler.section("draw");
+	bool profiler_shown = false;
+	sf::ProfilerOverlay profiler_overlay(profiler, sf::AssetRegistry::instance().font("Assets\\BradBunR.ttf"));
+	profiler_overlay.setPosition({ window.getSize().x - sf::Profiler::FrameCount - 220.f, window.getSize().y - 330.f });
+
+	sf::FramePacer pacer(window);
+	while (window.isOpen()) {
+		while (pacer.pollEvent(event)) {
+			if (event.type == sf::Event::Closed)
+				window.close();
+			else if (event.type == sf::Event::KeyPressed) {
+				if (event.key.code == sf::Keyboard::Escape)
+					return;
+				else if (event.key.code == sf::Keyboard::F2)
+					profiler_shown = !profiler_shown;
+			}
+		}
+
+		if (grid.update())
+			pacer.invalidate();
+		pacer.keepPolling();		// engine games don't wake window event queue
+
+		if (pacer.needsRedraw()) {
+			sf::ProfileScope draw_scope(draw_section);
+			window.clear();
+			window.draw(grid);
+			if (profiler_shown)
+				window.draw(profiler_overlay);
+			pacer.display();
+		}
+	}
+}
+
 ///////////////////////////////////////////////////
 /// Menu panel rendering function.
 ///////////////////////////////////////////////////
@@ -366,34 +667,50 @@ void menuRender(sf::RenderWindow& window) {
 		one_players_rbtn.setPosition({ window.getSize().x / 2.f + 120.f - 30, window.getSize().y / 2.f + 170.f });
 		one_players_rbtn.setCheckFillColor(sf::Color::Red);
 
-		sf::Font font;
-		font.loadFromFile("Assets\\Chase Dreams.ttf");
+		const sf::Font& font = sf::AssetRegistry::instance().font("Assets\\Chase Dreams.ttf");
 		sf::Text two_players_rbtn_label(font, "Play with Friend", 40);
 		two_players_rbtn_label.setPosition({ window.getSize().x / 2.f - 400, window.getSize().y / 2.f + 175.f });
 		sf::Text one_players_rbtn_label(font, "Play with Computer", 40);
 		one_players_rbtn_label.setPosition({ window.getSize().x / 2.f + 180, window.getSize().y / 2.f + 175.f });
+		sf::Text level_label(font, "", 30);		// Left and Right change difficulty while playing with computer is checked
+		auto update_level_label = [&]() {
+			level_label.setString(std::string("< ") + Hexxagon::Difficulties[ai_level].name + " >");
+			level_label.setPosition({ one_players_rbtn_label.getPosition().x + one_players_rbtn_label.getLocalBounds().getSize().x / 2.f - level_label.getLocalBounds().getSize().x / 2.f,
+				window.getSize().y / 2.f + 230.f });
+		};
+		update_level_label();
 
 		bool text_field_opened = false;
-		sf::Font font1;
-		font1.loadFromFile("Assets\\BradBunR.ttf");
+		const sf::Font& font1 = sf::AssetRegistry::instance().font("Assets\\BradBunR.ttf");
 		sf::TextField text_field = sf::TextField({300.f, 50.f}, font1, sf::Color::White, 30, 3, sf::Color::White);
 		text_field.setFillColor(sf::Color::Black);
-		text_field.setPosition({ window.getSize().x / 2.f - text_field.getSize().x / 2.f, window.getSize().y / 2.f - text_field.getSize().y / 2.f});
+		text_field.setPosition({ window.getSize().x / 2.f - text_field.getSize().x / 2.f, 90.f });
 
-		sf::Text text_title(font1, "Enter save name:", 40);
-		text_title.setPosition({ window.getSize().x / 2.f - text_title.getGlobalBounds().getSize().x / 2.f, window.getSize().y / 4.f - text_field.getSize().y / 2.f });
+		sf::Text text_title(font1, "Choose save:", 40);
+		text_title.setPosition({ window.getSize().x / 2.f - text_title.getGlobalBounds().getSize().x / 2.f, 25.f });
 		bool wrong = false;
+
+		sf::SaveBrowser browser({ 700.f, 8 * sf::SaveBrowser::RowHeight }, font1, Hexxagon::Topology::standard());
+		browser.setPosition({ window.getSize().x / 2.f - browser.getSize().x / 2.f, 170.f });
+
+		sf::FramePacer pacer(window);
+		auto open_save = [&](const string& name) {
+			text_field_opened = false;
+			gameRender(window, name);
+			text_field.clear();
+			pacer.invalidate();
+		};
 		while (window.isOpen()) {
-			window.clear();
-			while (window.pollEvent(event)) {
+			while (pacer.pollEvent(event)) {
 				if (event.type == sf::Event::Closed) {
 					window.close();
 					return;
 				}
 				else if (event.type == sf::Event::KeyPressed) {
+					pacer.invalidate();
 					if (wrong) {
 						wrong = false;
-						text_title.setString("Enter save name:");
+						text_title.setString("Choose save:");
 						text_title.setFillColor(sf::Color::White);
 					}
 					if (event.key.code == sf::Keyboard::Escape) {
@@ -406,12 +723,21 @@ void menuRender(sf::RenderWindow& window) {
 							return;
 						}
 					}
+					else if (!text_field_opened && one_players_rbtn.isChecked() &&
+						(event.key.code == sf::Keyboard::Left || event.key.code == sf::Keyboard::Right)) {
+						ai_level = std::clamp(ai_level + (event.key.code == sf::Keyboard::Left ? -1 : 1), 0, (int)Hexxagon::Difficulties.size() - 1);
+						update_level_label();
+					}
 					else if (text_field_opened && event.key.code == sf::Keyboard::Enter) {
 						string path = "Saves\\" + text_field.getText() + (text_field.getText().ends_with(".bin") ? "" : ".bin");
+						Hexxagon::IoWorker::instance().flush();
 						if (std::filesystem::exists(path)) {
-							text_field_opened = false;
-							gameRender(window, text_field.getText());
-							text_field.clear();
+							open_save(text_field.getText());
+							continue;
+						}
+						else if (browser.getSelected() != nullptr) {
+							open_save(browser.getSelected()->name);
+							continue;
 						}
 						else {
 							text_title.setString("Wrong filename!");
@@ -423,48 +749,145 @@ void menuRender(sf::RenderWindow& window) {
 
 				if (text_field_opened) {
 					text_field.handleEvent(window, event);
+					browser.handleEvent(window, event);
+					browser.setFilter(text_field.getText());
 				}
 				else {
 					new_game_btn.handleEvent(window, event);
-					continue_btn.handleEvent(window, event);
+					if (saves_enabled)
+						continue_btn.handleEvent(window, event);
 					high_score_btn.handleEvent(window, event);
 					one_players_rbtn.handleEvent(window, event);
 					two_players_rbtn.handleEvent(window, event);
 				}
 			}
 
-			if (text_field_opened) {
-				window.draw(text_field);
-				window.draw(text_title);
-			}
-			else {
-				if (new_game_btn.wasClicked())
+			if (!text_field_opened) {
+				if (new_game_btn.wasClicked()) {
 					gameRender(window, one_players_rbtn.isChecked());
-				else if (high_score_btn.wasClicked())
+					pacer.invalidate();
+				}
+				else if (high_score_btn.wasClicked()) {
 					highScorePanelRender(window);
-				else if (continue_btn.wasClicked())
+					pacer.invalidate();
+				}
+				else if (continue_btn.wasClicked()) {
 					text_field_opened = true;
-
-				window.draw(new_game_btn);
-				window.draw(continue_btn);
-				window.draw(high_score_btn);
-				window.draw(one_players_rbtn);
-				window.draw(two_players_rbtn);
-				window.draw(one_players_rbtn_label);
-				window.draw(two_players_rbtn_label);
+					browser.setEntries(Hexxagon::SaveIndex::instance().getEntries());
+					pacer.invalidate();
+				}
+			}
+			else if (browser.wasPicked()) {
+				open_save(browser.getSelected()->name);
+			}
+			else {
+				if (browser.update())
+					pacer.invalidate();
+				if (browser.isLoading())
+					pacer.keepPolling();		// thumbnails don't wake window event queue
 			}
 
-			window.display();
+			if (new_game_btn.wasChanged() | continue_btn.wasChanged() | high_score_btn.wasChanged() |
+				one_players_rbtn.wasChanged() | two_players_rbtn.wasChanged() | text_field.wasChanged() | browser.wasChanged())
+				pacer.invalidate();
+
+			if (pacer.needsRedraw()) {
+				window.clear();
+				if (text_field_opened) {
+					window.draw(text_field);
+					window.draw(text_title);
+					window.draw(browser);
+				}
+				else {
+					window.draw(new_game_btn);
+					if (saves_enabled)
+						window.draw(continue_btn);
+					window.draw(high_score_btn);
+					window.draw(one_players_rbtn);
+					window.draw(two_players_rbtn);
+					window.draw(one_players_rbtn_label);
+					window.draw(two_players_rbtn_label);
+					if (one_players_rbtn.isChecked())
+						window.draw(level_label);
+				}
+				pacer.display();
+			}
 		}
 	}
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+	unsigned int frame_limit = 60;
+	bool vertical_sync = false;
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		try {
+			if (arg == "--fps" && i + 1 < argc)
+				frame_limit = std::stoi(argv[++i]);
+			else if (arg == "--vsync")
+				vertical_sync = true;
+			else if (arg == "--autosave" && i + 1 < argc)
+				autosave_steps = std::stoi(argv[++i]);
+			else if (arg == "--spectate" && i + 1 < argc)
+				spectated_games = std::stoi(argv[++i]);
+			else if (arg == "--host" && i + 1 < argc) {
+				net_hosting = true;
+				net_port = (std::uint16_t)std::stoi(argv[++i]);
+			}
+			else if (arg == "--server-ai")
+				net_computer = true;
+			else if (arg == "--level" && i + 1 < argc)
+				ai_level = std::clamp(std::stoi(argv[++i]), 0, (int)Hexxagon::Difficulties.size() - 1);
+			else if (arg == "--connect" && i + 1 < argc) {
+				string address = argv[++i];
+				std::size_t colon = address.rfind(':');
+				net_host = address.substr(0, colon);
+				net_port = colon == string::npos ? 7777 : (std::uint16_t)std::stoi(address.substr(colon + 1));
+			}
+			else if (arg == "--board" && i + 1 < argc) {
+				if (auto descriptor = Hexxagon::TopologyDescriptor::load(argv[++i])) {
+					custom_topology.emplace(*descriptor);
+					board_topology = &*custom_topology;
+					saves_enabled = false;
+				}
+			}
+		}
+		catch (const std::logic_error&) {		// std::stoi of a value, which isn't a number
+			std::cout << "Invalid value of option " << arg << ": " << argv[i] << "\n";
+			return 1;
+		}
+	}
+
+	sf::AssetRegistry::instance().preload(
+		{ "Assets\\BradBunR.ttf", "Assets\\Chase Dreams.ttf" },
+		{
+			"Assets\\New Game\\Regular.png", "Assets\\New Game\\Pressed.png", "Assets\\New Game\\Hover.png",
+			"Assets\\Continue\\Regular.png", "Assets\\Continue\\Pressed.png", "Assets\\Continue\\Hover.png",
+			"Assets\\High Score\\Regular.png", "Assets\\High Score\\Pressed.png", "Assets\\High Score\\Hover.png"
+		});
+
+	if ((net_hosting && !Hexxagon::GameServer::Supported) || ((net_hosting || !net_host.empty()) && !Hexxagon::NetClient::Supported)) {
+		std::cout << "Network games are not supported on this platform\n";
+		return 1;
+	}
+
+	if (saves_enabled)
+		Hexxagon::SaveIndex::instance().scan(Hexxagon::Topology::standard());
+
 	sf::RenderWindow window(
 		sf::VideoMode({ 1250, 700 }),
 		"TITILE");
+	window.setVerticalSyncEnabled(vertical_sync);
+	window.setFramerateLimit(vertical_sync ? 0 : frame_limit);
 
-	menuRender(window);
+	if (spectated_games > 0)
+		spectatorRender(window, spectated_games);
+	else if (net_hosting || !net_host.empty())
+		networkRender(window);
+	else
+		menuRender(window);
 
+	sf::AssetRegistry::instance().wait();
+	Hexxagon::IoWorker::instance().flush();
 	return 0;
 }
\ No newline at end of file
@@ -9,7 +9,19 @@
 #include <algorithm>
 #include <fstream>
 #include <sstream>
+#include <iomanip>
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
 #include "GameBoard.h"
+#include "Analysis.h"
+#include "HintEngine.h"
 #include "ExtendedAssets.h"
+#include "ScoreRec.h"
+#include "SaveBrowser.h"
+#include "Spectator.h"
+#include "GameServer.h"
+#include "NetClient.h"
 
@@ -2,109 +2,130 @@
 namespace Hexxagon
 {
 	////////////////////////////////////////////////////////////
-	HexxagonAI::HexxagonAI(Board* board) : board(board), fields(board->getFields()) {
-		std::srand(std::time(nullptr));
+	HexxagonAI::HexxagonAI(Board* board) :
+		board(board),
+		random_state((std::uint64_t)std::time(nullptr))
+	{
+		noise_seed = splitmix64(random_state);
 	};
 
 	////////////////////////////////////////////////////////////
-	std::vector<StepField*> HexxagonAI::getOccupiedFields() const
+	HexxagonAI::~HexxagonAI()
 	{
-		std::vector<StepField*> v{};
-		for (StepField* field : board->getFields()) {
-			if (field != nullptr && field->isOccupied() && field->getGameChip()->getColor() == sf::Color::Blue) {
-				v.push_back(field);
-			}
-		}
-		return v;
+		abort = true;
+		if (pending.valid())
+			pending.wait();
 	}
 
 	////////////////////////////////////////////////////////////
-	std::vector<StepField*> HexxagonAI::getAvailableFields() const
+	const OpeningBook& HexxagonAI::getBook()
 	{
-		std::set<StepField*> s{};
-		for (StepField* field : getOccupiedFields()) {
-			if (field->getGameChip()->canMakeStep())
-				s.insert(field);
-		}
-		return std::vector<StepField*>(s.begin(), s.end());
+		static const OpeningBook book = [] {
+			OpeningBook book;
+			book.load("Assets\\book.bin");
+			return book;
+		}();
+		return book;
 	}
 
 	////////////////////////////////////////////////////////////
-	void HexxagonAI::makeStep() const
+	const EvalWeights& HexxagonAI::getWeights()
 	{
-		std::vector<StepField*> v = getAvailableFields();
-		auto range = std::ranges::partition(v, [](StepField* f) -> bool {return f->isBorder(); });
-
-		StepField* selectedField = nullptr;
-		StepField* nextStepField = nullptr;
-		int buff_count = 0;
-		int count = 0;
-
-		if (v.size() > 0) {
-			/////////////////////////////////////////////////////////
-			/// Checking the edge gamechips for the near move
-			/////////////////////////////////////////////////////////
-			for (auto iter_i = v.begin(); iter_i < range.begin() && buff_count != 5; iter_i++) {
-				std::vector<StepField*> v1 = (*iter_i)->getFreeCloseNeighbours();
-				if(v1.size() > 0)
-					for (auto iter_j = v1.begin(); iter_j < v1.end() && buff_count != 5; iter_j++) {
-						buff_count = (*iter_j)->getNearestGamechipCount(sf::Color::Red) > count;
-						if (buff_count > count) {
-							selectedField = *iter_i;
-							nextStepField = (*iter_j);
-							count = buff_count;
-						}
-					}
-			}
+		static const EvalWeights weights = [] {
+			EvalWeights weights;
+			weights.load("Assets\\weights.txt");
+			return weights;
+		}();
+		return weights;
+	}
 
-			if (count != 5) {
-				/////////////////////////////////////////////////////////
-				/// Checking the edge gamechips for the distant move
-				/////////////////////////////////////////////////////////
-				for (auto iter_i = v.begin(); iter_i < range.begin() && buff_count != 5; iter_i++) {
-					std::vector<StepField*> v1 = (*iter_i)->getFreeDistantNeighbours();
-					if (v1.size() > 0)
-						for (auto iter_j = v1.begin(); iter_j < v1.end() && buff_count != 5; iter_j++) {
-							buff_count = (*iter_j)->getNearestGamechipCount(sf::Color::Red);
-							if (buff_count > 1 && buff_count > count) {
-								selectedField = *iter_i;
-								nextStepField = (*iter_j);
-								count = buff_count;
-							}
-						}
-				}
-
-				/////////////////////////////////////////////////////////
-				/// Checking the edge gamechips for the distant move
-				/////////////////////////////////////////////////////////
-				for (auto iter_i = range.begin(); iter_i < range.end() && buff_count != 5; iter_i++) {
-					std::vector<StepField*> v1 = (*iter_i)->getFreeDistantNeighbours();
-					if (v1.size() > 0)
-						for (auto iter_j = v1.begin(); iter_j < v1.end() && buff_count != 5; iter_j++) {
-							buff_count = (*iter_j)->getNearestGamechipCount(sf::Color::Red);
-							if (buff_count > 1 && buff_count > count) {
-								selectedField = *iter_i;
-								nextStepField = (*iter_j);
-								count = buff_count;
-							}
-						}
-				}
-			}
+	////////////////////////////////////////////////////////////
+	const Network* HexxagonAI::getNetwork()
+	{
+		static const std::unique_ptr<Network> network = [] {
+			auto network = std::make_unique<Network>();
+			return network->load("Assets\\network.bin") ? std::move(network) : nullptr;
+		}();
+		return network.get();
+	}
+
+	////////////////////////////////////////////////////////////
+	void HexxagonAI::makeStep()
+	{
+		pending = std::async(std::launch::async, &HexxagonAI::choose, this, board->toPosition(), difficulty);
+	}
+
+	////////////////////////////////////////////////////////////
+	bool HexxagonAI::finishStep()
+	{
+		if (!pending.valid() || pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			return false;
+		Choice choice = pending.get();
+		stats = choice.stats;
+		source = choice.source;
+
+		board->clearSelected();
+		if (choice.move)
+			board->play(*choice.move);
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	bool HexxagonAI::isThinking() const { return pending.valid(); }
+
+	////////////////////////////////////////////////////////////
+	HexxagonAI::Choice HexxagonAI::choose(const Position& position, int level_index)
+	{
+		Choice choice;
+
+		/////////////////////////////////////////////////////////
+		/// Book is built on the standard game board only
+		/////////////////////////////////////////////////////////
+		const Difficulty& level = Difficulties[level_index];
+		if (level.book && &position.getTopology() == &Topology::standard())
+			choice.move = getBook().probe(position, [this](unsigned int bound) { return (unsigned int)(splitmix64(random_state) % bound); });
+		if (choice.move)
+			choice.source = "book";
 
-			if (selectedField == nullptr || nextStepField == nullptr) {
-				if (range.begin() - v.begin() > 0) {
-					selectedField = v.at(std::rand() % (range.begin() - v.begin()));
-					std::vector<StepField*> v1 = selectedField->getFreeCloseNeighbours();
-					if (v1.size() > 0)
-						nextStepField = *v1.begin();
-					else
-						nextStepField = *selectedField->getFreeDistantNeighbours().begin();
-				}
+		if (!choice.move && level.endgame && position.getEmpty().count() <= EndgameSolver::EmptyThreshold) {
+			if (!solver)
+				solver = std::make_unique<EndgameSolver>();
+			EndgameResult result = solver->solve(position, SolverNodes);
+			if (result.solved) {
+				choice.move = result.move;
+				choice.source = "endgame";
+				choice.stats.score = result.margin;
 			}
 		}
 
-		board->clearSelected();
-		board->selected_f = selectedField;
-		board->makeStep(nextStepField);
+		if (!choice.move) {
+			if (!search) {
+				search = std::make_unique<Search>();
+				search->setWeights(getWeights());
+				search->setNetwork(getNetwork());
+			}
+			search->setNoise(level.noise, noise_seed);
+			SearchLimits limits = level.getLimits();
+			limits.stop = &abort;
+			SearchResult result = search->run(position, limits);
+			if (result.found) {
+				choice.move = result.move;
+				choice.source = "search";
+				choice.stats = search->getStats();
+			}
+		}
+		return choice;
 	}
+
+	////////////////////////////////////////////////////////////
+	void HexxagonAI::setDifficulty(int level) { difficulty = std::clamp(level, 0, (int)Difficulties.size() - 1); }
+
+	////////////////////////////////////////////////////////////
+	int HexxagonAI::getDifficulty() const { return difficulty; }
+
+	////////////////////////////////////////////////////////////
+	const SearchStats& HexxagonAI::getStats() const { return stats; }
+
+	////////////////////////////////////////////////////////////
+	const char* HexxagonAI::getSource() const { return source; }
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
-#include <set>
-#include <vector>
-#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <optional>
+#include "Difficulty.h"
+#include "Endgame.h"
+#include "OpeningBook.h"
+#include "Search.h"
 
 #pragma once
 
@@ -11,22 +16,89 @@ namespace Hexxagon
 
 	/////////////////////////////////////////////////////////
 	/// Basic Hexxagon AI class which implements
-	/// algorithms for game with computer.
+	/// algorithms for game with computer: opening book
+	/// moves first, searched moves after the book ends
+	/// and solved moves when few empty cells are left.
+	/// Difficulty level limits the search and turns the
+	/// book and the solver off for weak levels.
+	///
+	/// Step is chosen on a worker thread, so the window stays
+	/// responsive while the computer thinks. Engine members
+	/// belong to the worker until finishStep() takes it's
+	/// choice.
 	/////////////////////////////////////////////////////////
 	class HexxagonAI
 	{
 	private:
+		struct Choice
+		{
+			std::optional<Move> move;
+			const char* source = "";
+			SearchStats stats;
+		};
+
 		Board* board;
 
-		std::vector<StepField*> fields;
+		std::unique_ptr<Search> search;		//!< created on first step, to not hold the table in games without computer
+
+		std::unique_ptr<EndgameSolver> solver;		//!< created on first endgame step
+
+		SearchStats stats;		//!< statistics of the last step, empty for book moves
+
+		const char* source = "";		//!< where the last step came from: "book", "endgame" or "search"
+
+		int difficulty = DefaultDifficulty;		//!< index into Difficulties
+
+		std::uint64_t random_state;		//!< splitmix64 state for book choices, seeded with time
+
+		std::uint64_t noise_seed;		//!< evaluation noise of weak levels, fixed for the game
+
+		std::future<Choice> pending;		//!< step being chosen by the worker
+
+		std::atomic<bool> abort = false;		//!< stops the worker's search, when the game is left
+
+		static constexpr std::uint64_t SolverNodes = 1000000;		//!< solver gives up to the search after it
 
-		std::vector<StepField*> getOccupiedFields() const;		//!< returns all occupied fields
+		/// Opening book of the standard game board, loaded once
+		/// from "Assets\book.bin". Empty if file is missing.
+		///
+		static const OpeningBook& getBook();
 
-		std::vector<StepField*> getAvailableFields() const;		//!< returns fields which contains gamechips available for step
+		Choice choose(const Position& position, int level_index);		//!< runs on the worker
 
 	public:
+		/// Evaluation weights, loaded once from "Assets\weights.txt"
+		/// written by hexxagon_tune. Defaults if file is missing.
+		///
+		static const EvalWeights& getWeights();
+
+		/// Evaluation network, loaded once from
+		/// "Assets\network.bin". nullptr if file is missing.
+		///
+		static const Network* getNetwork();
+
 		HexxagonAI(Board* board);
 
-		void makeStep() const;		//!< basic AI logic
+		HexxagonAI(const HexxagonAI&) = delete;
+		HexxagonAI& operator=(const HexxagonAI&) = delete;
+
+		~HexxagonAI();		//!< stops the search of pending step and waits for it
+
+		void makeStep();		//!< starts choosing step of the board's position and returns at once
+
+		/// Plays chosen step on the board, if the worker has
+		/// finished. Returns 'true' if the step was taken.
+		///
+		bool finishStep();
+
+		bool isThinking() const;		//!< returns 'true' while a step is being chosen
+
+		void setDifficulty(int level);		//!< index into Difficulties
+
+		int getDifficulty() const;
+
+		const SearchStats& getStats() const;
+
+		const char* getSource() const;
 	};
-}
\ No newline at end of file
+}
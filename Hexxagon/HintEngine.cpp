@@ -0,0 +1,97 @@
+#include "HintEngine.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    HintEngine::HintEngine(const EvalWeights& weights, const Network* network, int ponder_milliseconds, std::size_t capacity) :
+        ponder_milliseconds(ponder_milliseconds),
+        capacity(capacity)
+    {
+        search.setWeights(weights);
+        search.setNetwork(network);
+        thread = std::thread(&HintEngine::run, this);
+    }
+
+    ////////////////////////////////////////////////////////////
+    HintEngine::~HintEngine()
+    {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+            interrupt = true;
+        }
+        wake.notify_one();
+        thread.join();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void HintEngine::ponder(const Position& position)
+    {
+        {
+            std::lock_guard lock(mutex);
+            if (searching == position.getHash()) {
+                target.reset();     // already on it, only drop whatever came after
+                interrupt = false;
+                return;
+            }
+            auto entry = cache.find(position.getHash());
+            if (entry != cache.end() && entry->second.complete)
+                target.reset();
+            else
+                target = position;
+            interrupt = searching.has_value();
+        }
+        wake.notify_one();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void HintEngine::cancel()
+    {
+        std::lock_guard lock(mutex);
+        target.reset();
+        interrupt = searching.has_value();
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::optional<HintEngine::Hint> HintEngine::probe(const Position& position) const
+    {
+        std::lock_guard lock(mutex);
+        auto entry = cache.find(position.getHash());
+        if (entry == cache.end())
+            return std::nullopt;
+        return entry->second.hint;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void HintEngine::run()
+    {
+        std::unique_lock lock(mutex);
+        while (true) {
+            wake.wait(lock, [this] { return target.has_value() || stopping; });
+            if (stopping)
+                return;
+            Position position = *target;
+            target.reset();
+            if (position.isGameOver())
+                continue;
+            searching = position.getHash();
+            interrupt = false;
+            lock.unlock();
+
+            SearchLimits limits;
+            limits.milliseconds = ponder_milliseconds;
+            limits.stop = &interrupt;
+            SearchResult result = search.run(position, limits);
+
+            lock.lock();
+            searching.reset();
+            if (result.depth == 0)
+                continue;       // stopped before the first iteration, the move is a guess
+            if (cache.size() >= capacity && !cache.contains(position.getHash()))
+                cache.clear();
+            Entry& entry = cache[position.getHash()];
+            if (result.depth >= entry.hint.depth)
+                entry = { { result.move, result.score, result.depth }, !interrupt };
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include "Search.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    /// Best moves for hints, searched on a background thread
+    /// while the player thinks and kept for the whole session
+    /// by Zobrist hash, so a repeated hint or a position seen
+    /// again are answered at once.
+    ///
+    /// ponder() switches the thread to a new position, stopping
+    /// the running search. A stopped search still stores it's
+    /// completed iterations, which ponder() deepens later.
+    ////////////////////////////////////////////////////////////
+    class HintEngine
+    {
+    public:
+        struct Hint
+        {
+            Move move;
+            int score = 0;      //!< for the side to move
+            int depth = 0;
+        };
+
+    private:
+        struct Entry
+        {
+            Hint hint;
+            bool complete = false;      //!< 'false' if search was stopped before it's time ran out
+        };
+
+        int ponder_milliseconds;
+        std::size_t capacity;
+        Search search;      //!< used by the thread only
+
+        mutable std::mutex mutex;
+        std::condition_variable wake;
+        std::unordered_map<std::uint64_t, Entry> cache;
+        std::optional<Position> target;     //!< position waiting for search
+        std::optional<std::uint64_t> searching;     //!< hash of the position being searched
+        std::atomic<bool> interrupt = false;        //!< stops running search
+        bool stopping = false;
+        std::thread thread;
+
+        void run();
+
+    public:
+        /// Searches with provided evaluation, both have to
+        /// outlive the engine. Cache is cleared, when it
+        /// reaches 'capacity' positions.
+        ///
+        HintEngine(const EvalWeights& weights, const Network* network, int ponder_milliseconds = 2000, std::size_t capacity = 1 << 16);
+
+        HintEngine(const HintEngine&) = delete;
+        HintEngine& operator=(const HintEngine&) = delete;
+
+        ~HintEngine();
+
+        /// Starts searching the position in background, unless
+        /// it was searched already. Returns at once.
+        ///
+        void ponder(const Position& position);
+
+        void cancel();      //!< stops searching, e.g. while computer takes it's step
+
+        /// Returns cached best move of the position, nothing if
+        /// it wasn't searched yet.
+        ///
+        std::optional<Hint> probe(const Position& position) const;
+    };
+}
@@ -0,0 +1,92 @@
+#include "IoWorker.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    IoWorker::IoWorker() : thread(&IoWorker::run, this) {}
+
+    ////////////////////////////////////////////////////////////
+    IoWorker::~IoWorker()
+    {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        thread.join();
+    }
+
+    ////////////////////////////////////////////////////////////
+    IoWorker& IoWorker::instance()
+    {
+        static IoWorker worker;
+        return worker;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void IoWorker::write(const std::string& path, std::string contents)
+    {
+        {
+            std::lock_guard lock(mutex);
+            auto iter = std::find_if(jobs.begin(), jobs.end(), [&path](const Job& job) -> bool { return job.path == path; });
+            if (iter != jobs.end())
+                iter->contents = std::move(contents);
+            else
+                jobs.push_back({ path, std::move(contents) });
+        }
+        wake.notify_one();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void IoWorker::flush()
+    {
+        std::unique_lock lock(mutex);
+        idle.wait(lock, [this] { return jobs.empty() && !busy; });
+    }
+
+    ////////////////////////////////////////////////////////////
+    void IoWorker::run()
+    {
+        std::unique_lock lock(mutex);
+        while (true) {
+            wake.wait(lock, [this] { return !jobs.empty() || stopping; });
+            if (jobs.empty())
+                return;     // stopping, with every file written
+
+            Job job = std::move(jobs.front());
+            jobs.pop_front();
+            busy = true;
+            lock.unlock();
+
+            if (!writeAtomically(job.path, job.contents))
+                std::cerr << "File " << job.path << " could not be written\n";
+
+            lock.lock();
+            busy = false;
+            if (jobs.empty())
+                idle.notify_all();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool IoWorker::writeAtomically(const std::string& path, const std::string& contents)
+    {
+        const std::string temp_path = path + ".tmp";
+        {
+            std::fstream stream(temp_path, std::ios::out | std::ios::trunc);
+            if (!stream.write(contents.data(), contents.size()) || !stream.flush())
+                return false;
+        }
+        std::error_code error;
+        std::filesystem::rename(temp_path, path, error);
+        if (error) {
+            std::filesystem::remove(temp_path, error);
+            return false;
+        }
+        return true;
+    }
+}
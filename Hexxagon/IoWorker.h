@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    /// Background thread, which writes files for the render
+    /// loop, so saves don't stall frames on slow disks.
+    ///
+    /// Every file is written to "<path>.tmp" first and renamed
+    /// over the old one, so a crash never leaves half a file.
+    /// When a path is queued again before it was written, only
+    /// the newest contents are kept.
+    ////////////////////////////////////////////////////////////
+    class IoWorker
+    {
+    private:
+        struct Job
+        {
+            std::string path;
+            std::string contents;
+        };
+
+        std::mutex mutex;
+        std::condition_variable wake;       //!< signals new jobs and stopping
+        std::condition_variable idle;       //!< signals empty queue
+        std::deque<Job> jobs;
+        bool busy = false;      //!< 'true' while a taken job is being written
+        bool stopping = false;
+        std::thread thread;
+
+        IoWorker();
+
+        void run();
+
+    public:
+        IoWorker(const IoWorker&) = delete;
+        IoWorker& operator=(const IoWorker&) = delete;
+
+        ~IoWorker();        //!< writes all queued files before exit
+
+        static IoWorker& instance();
+
+        /// Queues file write and returns at once.
+        ///
+        void write(const std::string& path, std::string contents);
+
+        /// Waits until all queued files are written. Has to be
+        /// called before reading a file, which may be queued.
+        ///
+        void flush();
+
+        /// Writes file through a temporary one and renames it
+        /// over the target. Returns 'false' on failure.
+        ///
+        static bool writeAtomically(const std::string& path, const std::string& contents);
+    };
+}
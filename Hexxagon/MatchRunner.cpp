@@ -0,0 +1,99 @@
+#include "MatchRunner.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include "Search.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    MatchRunner::MatchRunner(int board_count, int thread_count, int move_milliseconds, const Topology& topology) :
+        topology(topology),
+        move_milliseconds(move_milliseconds),
+        boards(board_count)
+    {
+        thread_count = std::max(1, std::min(thread_count, board_count));
+        for (int i = 0; i < thread_count; i++)
+            threads.emplace_back(&MatchRunner::run, this, i, thread_count);
+    }
+
+    ////////////////////////////////////////////////////////////
+    MatchRunner::~MatchRunner()
+    {
+        stopping = true;
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void MatchRunner::run(int thread, int thread_count)
+    {
+        struct Game
+        {
+            int board;
+            Position position;
+            std::mt19937 random;
+            MatchSnapshot snapshot;
+            std::chrono::steady_clock::time_point finished;
+        };
+
+        auto publish = [this](const Game& game) {
+            MatchSnapshot& snapshot = boards[game.board].writeBuffer();
+            snapshot = game.snapshot;
+            snapshot.pieces[Position::Red] = game.position.getPieces(Position::Red);
+            snapshot.pieces[Position::Blue] = game.position.getPieces(Position::Blue);
+            snapshot.side = game.position.getSide();
+            boards[game.board].publish();
+        };
+        auto start = [this, &publish](Game& game) {
+            game.position = Position(topology);
+            game.snapshot = MatchSnapshot();
+            game.snapshot.game = next_game++;
+            game.random.seed(game.snapshot.game);
+            publish(game);
+        };
+
+        std::vector<Game> games;
+        for (int board = thread; board < size(); board += thread_count) {
+            games.push_back({ board, Position(topology), std::mt19937(), MatchSnapshot(), std::chrono::steady_clock::time_point() });
+            start(games.back());
+        }
+
+        Search search(8);
+        MoveList moves;
+        while (!stopping) {
+            bool played = false;
+            for (Game& game : games) {
+                if (stopping)
+                    return;
+                if (game.snapshot.over) {
+                    if (std::chrono::steady_clock::now() - game.finished >= std::chrono::milliseconds(PauseMilliseconds))
+                        start(game);
+                    continue;
+                }
+
+                Move move;
+                if (game.snapshot.ply < RandomPlies) {
+                    game.position.generateMoves(moves);
+                    move = moves[game.random() % moves.size()];
+                }
+                else {
+                    SearchLimits limits;
+                    limits.milliseconds = move_milliseconds;
+                    move = search.run(game.position, limits).move;
+                }
+                game.position.make(move);
+                game.snapshot.last = move;
+                game.snapshot.ply++;
+                if (game.position.isGameOver() || game.snapshot.ply >= MaxPlies) {
+                    game.snapshot.over = true;
+                    game.finished = std::chrono::steady_clock::now();
+                }
+                publish(game);
+                played = true;
+            }
+            if (!played)
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    }
+}
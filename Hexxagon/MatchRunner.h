@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "Position.h"
+#include "TripleBuffer.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    /// State of one watched game, as the spectator view sees it.
+    ////////////////////////////////////////////////////////////
+    struct MatchSnapshot
+    {
+        Bitboard pieces[2];
+        int side = Position::Red;
+        int game = 0;       //!< number of the game played on the board
+        int ply = 0;
+        Move last;      //!< last made move, valid if ply > 0
+        bool over = false;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Engine-vs-engine games played on background threads for
+    /// the spectator view. Every thread plays a share of boards
+    /// by turns, one move each, and publishes every position
+    /// through a TripleBuffer, so renderer never waits on them.
+    ////////////////////////////////////////////////////////////
+    class MatchRunner
+    {
+    public:
+        static constexpr int RandomPlies = 4;       //!< random moves at the start, so games differ
+        static constexpr int MaxPlies = 300;        //!< jumps alone can repeat forever, longer games are stopped
+        static constexpr int PauseMilliseconds = 3000;      //!< finished game stays on screen so long
+
+    private:
+        const Topology& topology;
+        int move_milliseconds;
+        std::vector<TripleBuffer<MatchSnapshot>> boards;
+        std::atomic<int> next_game = 0;
+        std::atomic<bool> stopping = false;
+        std::vector<std::thread> threads;
+
+        void run(int thread, int thread_count);
+
+    public:
+        MatchRunner(int board_count, int thread_count, int move_milliseconds, const Topology& topology = Topology::standard());
+
+        MatchRunner(const MatchRunner&) = delete;
+        MatchRunner& operator=(const MatchRunner&) = delete;
+
+        ~MatchRunner();     //!< stops after current moves
+
+        int size() const { return (int)boards.size(); }
+
+        const Topology& getTopology() const { return topology; }
+
+        /// Reader side, for one thread only.
+        ///
+        bool update(int board) { return boards[board].update(); }      //!< returns 'true' if board has new position
+
+        const MatchSnapshot& get(int board) const { return boards[board].read(); }
+    };
+}
@@ -0,0 +1,114 @@
+#include "NetClient.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    NetClient::~NetClient()
+    {
+        disconnect();
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool NetClient::connect(const std::string& host, std::uint16_t port, std::uint8_t opponent)
+    {
+        disconnect();
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* addresses = nullptr;
+        if (::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses) != 0)
+            return false;
+
+        for (addrinfo* address = addresses; address != nullptr && socket < 0; address = address->ai_next) {
+            socket = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            if (socket >= 0 && ::connect(socket, address->ai_addr, address->ai_addrlen) < 0) {
+                ::close(socket);
+                socket = -1;
+            }
+        }
+        ::freeaddrinfo(addresses);
+        if (socket < 0)
+            return false;
+
+        int no_delay = 1;
+        ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+        ::fcntl(socket, F_SETFL, ::fcntl(socket, F_GETFL) | O_NONBLOCK);
+        send({ Message::Join, Message::Version, opponent });
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void NetClient::send(const Message& message)
+    {
+        if (socket < 0)
+            return;
+        std::uint8_t bytes[Message::Size];
+        message.write(bytes);
+        int sent = 0;
+        while (sent < Message::Size) {      // 3 bytes fit into socket buffer unless server stopped reading
+            ssize_t written = ::send(socket, bytes + sent, Message::Size - sent, MSG_NOSIGNAL);
+            if (written < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                disconnect();
+                return;
+            }
+            if (written > 0)
+                sent += (int)written;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::optional<Message> NetClient::receive()
+    {
+        while (socket >= 0) {
+            ssize_t read = ::recv(socket, input + received, Message::Size - received, 0);
+            if (read == 0 || (read < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                disconnect();
+                return Message{ Message::Left };
+            }
+            if (read < 0)
+                return std::nullopt;
+
+            received += (int)read;
+            if (received == Message::Size) {
+                received = 0;
+                return Message::read(input);
+            }
+        }
+        return std::nullopt;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void NetClient::disconnect()
+    {
+        if (socket >= 0)
+            ::close(socket);
+        socket = -1;
+        received = 0;
+    }
+}
+
+#else
+
+namespace Hexxagon
+{
+    NetClient::~NetClient() {}
+
+    bool NetClient::connect(const std::string&, std::uint16_t, std::uint8_t) { return false; }
+
+    void NetClient::send(const Message&) {}
+
+    std::optional<Message> NetClient::receive() { return std::nullopt; }
+
+    void NetClient::disconnect() {}
+}
+
+#endif
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include "Protocol.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    /// Client side of the network game: TCP connection to the
+    /// GameServer, polled by the render loop without blocking.
+    /// Works with POSIX sockets only; elsewhere connect() fails.
+    ////////////////////////////////////////////////////////////
+    class NetClient
+    {
+    public:
+#ifndef _WIN32
+        static constexpr bool Supported = true;
+#else
+        static constexpr bool Supported = false;        //!< no Winsock implementation yet
+#endif
+
+    private:
+        int socket = -1;
+        std::uint8_t input[Message::Size];
+        int received = 0;       //!< bytes of the input message
+
+    public:
+        NetClient() {};
+
+        NetClient(const NetClient&) = delete;
+        NetClient& operator=(const NetClient&) = delete;
+
+        ~NetClient();
+
+        /// Connects to the server and joins the queue of players,
+        /// or asks for a game against computer, see Message::Join.
+        /// Returns 'false' on failure.
+        ///
+        bool connect(const std::string& host, std::uint16_t port, std::uint8_t opponent = Message::Human);
+
+        void send(const Message& message);
+
+        /// Returns next message from the server, or nothing, if
+        /// none has arrived in full yet. Lost connection is
+        /// reported as Left.
+        ///
+        std::optional<Message> receive();
+
+        bool isConnected() const { return socket >= 0; }
+
+        void disconnect();
+    };
+}
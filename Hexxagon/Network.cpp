@@ -0,0 +1,207 @@
+#include "Network.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace Hexxagon
+{
+    namespace
+    {
+        constexpr char Magic[4] = { 'H', 'X', 'N', 'N' };
+
+        void add(std::int16_t* values, const std::int16_t* weights)
+        {
+#if defined(__AVX2__)
+            for (int i = 0; i < Accumulator::Hidden; i += 16) {
+                __m256i v = _mm256_load_si256((const __m256i*)(values + i));
+                __m256i w = _mm256_load_si256((const __m256i*)(weights + i));
+                _mm256_store_si256((__m256i*)(values + i), _mm256_add_epi16(v, w));
+            }
+#elif defined(__SSE2__) || defined(_M_X64)
+            for (int i = 0; i < Accumulator::Hidden; i += 8) {
+                __m128i v = _mm_load_si128((const __m128i*)(values + i));
+                __m128i w = _mm_load_si128((const __m128i*)(weights + i));
+                _mm_store_si128((__m128i*)(values + i), _mm_add_epi16(v, w));
+            }
+#else
+            for (int i = 0; i < Accumulator::Hidden; i++)
+                values[i] += weights[i];
+#endif
+        }
+
+        void subtract(std::int16_t* values, const std::int16_t* weights)
+        {
+#if defined(__AVX2__)
+            for (int i = 0; i < Accumulator::Hidden; i += 16) {
+                __m256i v = _mm256_load_si256((const __m256i*)(values + i));
+                __m256i w = _mm256_load_si256((const __m256i*)(weights + i));
+                _mm256_store_si256((__m256i*)(values + i), _mm256_sub_epi16(v, w));
+            }
+#elif defined(__SSE2__) || defined(_M_X64)
+            for (int i = 0; i < Accumulator::Hidden; i += 8) {
+                __m128i v = _mm_load_si128((const __m128i*)(values + i));
+                __m128i w = _mm_load_si128((const __m128i*)(weights + i));
+                _mm_store_si128((__m128i*)(values + i), _mm_sub_epi16(v, w));
+            }
+#else
+            for (int i = 0; i < Accumulator::Hidden; i++)
+                values[i] -= weights[i];
+#endif
+        }
+
+        /// Returns sum of clipped hidden values multiplied by weights.
+        ///
+        std::int32_t dot(const std::int16_t* values, const std::int16_t* weights)
+        {
+#if defined(__AVX2__)
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i max = _mm256_set1_epi16(Network::ActivationMax);
+            __m256i sum = _mm256_setzero_si256();
+            for (int i = 0; i < Accumulator::Hidden; i += 16) {
+                __m256i v = _mm256_min_epi16(_mm256_max_epi16(_mm256_load_si256((const __m256i*)(values + i)), zero), max);
+                sum = _mm256_add_epi32(sum, _mm256_madd_epi16(v, _mm256_load_si256((const __m256i*)(weights + i))));
+            }
+            __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+            half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+            half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+            return _mm_cvtsi128_si32(half);
+#elif defined(__SSE2__) || defined(_M_X64)
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i max = _mm_set1_epi16(Network::ActivationMax);
+            __m128i sum = _mm_setzero_si128();
+            for (int i = 0; i < Accumulator::Hidden; i += 8) {
+                __m128i v = _mm_min_epi16(_mm_max_epi16(_mm_load_si128((const __m128i*)(values + i)), zero), max);
+                sum = _mm_add_epi32(sum, _mm_madd_epi16(v, _mm_load_si128((const __m128i*)(weights + i))));
+            }
+            sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+            sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+            return _mm_cvtsi128_si32(sum);
+#else
+            std::int32_t sum = 0;
+            for (int i = 0; i < Accumulator::Hidden; i++)
+                sum += std::clamp<std::int32_t>(values[i], 0, Network::ActivationMax) * weights[i];
+            return sum;
+#endif
+        }
+
+        void writeLE(std::vector<char>& out, std::uint64_t value, int bytes)
+        {
+            for (int i = 0; i < bytes; i++)
+                out.push_back((char)((value >> (i * 8)) & 0xFF));
+        }
+
+        std::uint64_t readLE(const char*& in, int bytes)
+        {
+            std::uint64_t value = 0;
+            for (int i = 0; i < bytes; i++)
+                value |= (std::uint64_t)(unsigned char)in[i] << (i * 8);
+            in += bytes;
+            return value;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    Network::Network()
+    {
+        std::memset(input_weights, 0, sizeof(input_weights));
+        std::memset(hidden_biases, 0, sizeof(hidden_biases));
+        std::memset(output_weights, 0, sizeof(output_weights));
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool Network::load(const std::string& path)
+    {
+        constexpr std::size_t size = 12 + (Inputs * Hidden + Hidden + 2 * Hidden) * 2 + 4;
+        std::fstream stream(path, std::ios::in | std::ios::binary);
+        std::vector<char> data(size);
+        if (!stream.read(data.data(), data.size()) || std::memcmp(data.data(), Magic, 4) != 0)
+            return false;
+
+        const char* in = data.data() + 4;
+        if (readLE(in, 4) != Version || readLE(in, 4) != Hidden)
+            return false;
+
+        for (auto& weights : input_weights)
+            for (std::int16_t& weight : weights)
+                weight = (std::int16_t)readLE(in, 2);
+        for (std::int16_t& bias : hidden_biases)
+            bias = (std::int16_t)readLE(in, 2);
+        for (std::int16_t& weight : output_weights)
+            weight = (std::int16_t)readLE(in, 2);
+        output_bias = (std::int32_t)readLE(in, 4);
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool Network::save(const std::string& path) const
+    {
+        std::vector<char> data(Magic, Magic + 4);
+        writeLE(data, Version, 4);
+        writeLE(data, Hidden, 4);
+        for (const auto& weights : input_weights)
+            for (std::int16_t weight : weights)
+                writeLE(data, (std::uint16_t)weight, 2);
+        for (std::int16_t bias : hidden_biases)
+            writeLE(data, (std::uint16_t)bias, 2);
+        for (std::int16_t weight : output_weights)
+            writeLE(data, (std::uint16_t)weight, 2);
+        writeLE(data, (std::uint32_t)output_bias, 4);
+
+        std::fstream stream(path, std::ios::out | std::ios::trunc | std::ios::binary);
+        return (bool)stream.write(data.data(), data.size());
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Network::addCell(Accumulator& accumulator, int player, int index) const
+    {
+        for (int perspective : { Position::Red, Position::Blue })
+            add(accumulator.values[perspective], input_weights[input(perspective, player, index)]);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Network::removeCell(Accumulator& accumulator, int player, int index) const
+    {
+        for (int perspective : { Position::Red, Position::Blue })
+            subtract(accumulator.values[perspective], input_weights[input(perspective, player, index)]);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Network::refresh(const Position& position, Accumulator& accumulator) const
+    {
+        for (int perspective : { Position::Red, Position::Blue })
+            std::memcpy(accumulator.values[perspective], hidden_biases, sizeof(hidden_biases));
+        for (int player : { Position::Red, Position::Blue })
+            for (Bitboard pieces = position.getPieces(player); pieces; )
+                addCell(accumulator, player, pieces.popFirst());
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Network::update(const Accumulator& before, Accumulator& after, const Position& position, const Position::Undo& undo) const
+    {
+        const int player = 1 - position.getSide();      // side, which made the step
+        after = before;
+        addCell(after, player, undo.move.to);
+        if (!undo.move.isClone())
+            removeCell(after, player, undo.move.from);
+        for (Bitboard captured = undo.captured; captured; ) {
+            int index = captured.popFirst();
+            removeCell(after, 1 - player, index);
+            addCell(after, player, index);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    int Network::evaluate(const Accumulator& accumulator, int side) const
+    {
+        std::int64_t sum = output_bias;
+        sum += dot(accumulator.values[side], output_weights);
+        sum += dot(accumulator.values[1 - side], output_weights + Hidden);
+        return (int)(sum * ScoreScale / (ActivationMax * OutputScale));
+    }
+}
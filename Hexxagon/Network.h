@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Position.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    /// First layer outputs of both players' perspectives.
+    /// Kept per ply of the search and updated by the cells
+    /// changed by a step instead of being recomputed.
+    ////////////////////////////////////////////////////////////
+    struct Accumulator
+    {
+        static constexpr int Hidden = 64;
+
+        alignas(32) std::int16_t values[2][Hidden];
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Small neural evaluation: one input per cell per player
+    /// (own and opponent's gamechips from each perspective),
+    /// one hidden layer with clipped ReLU and a single output.
+    /// Weights are 16-bit integers, inference uses AVX2 or SSE2
+    /// when the compiler targets them.
+    ///
+    /// File layout: "HXNN" magic, 32-bit version, 32-bit hidden
+    /// size, then 16-bit input weights [2 * 128][hidden], hidden
+    /// biases [hidden], output weights [2 * hidden] and 32-bit
+    /// output bias, little-endian.
+    ////////////////////////////////////////////////////////////
+    class Network
+    {
+    public:
+        static constexpr std::uint32_t Version = 1;
+
+        static constexpr int Inputs = 2 * Bitboard::Capacity;
+        static constexpr int Hidden = Accumulator::Hidden;
+
+        static constexpr int ActivationMax = 255;      //!< hidden values are clipped to [0, ActivationMax]
+        static constexpr int OutputScale = 64;          //!< output weights are scaled by it
+        static constexpr int ScoreScale = 100;          //!< network output of 1.0 is worth one gamechip of evaluate()
+
+    private:
+        alignas(32) std::int16_t input_weights[Inputs][Hidden];
+        alignas(32) std::int16_t hidden_biases[Hidden];
+        alignas(32) std::int16_t output_weights[2 * Hidden];
+        std::int32_t output_bias = 0;
+
+        /// Returns input of the gamechip of the player in the cell,
+        /// as seen from the perspective.
+        ///
+        static int input(int perspective, int player, int index) { return (player == perspective ? 0 : Bitboard::Capacity) + index; }
+
+        void addCell(Accumulator& accumulator, int player, int index) const;
+
+        void removeCell(Accumulator& accumulator, int player, int index) const;
+
+    public:
+        Network();
+
+        /// Reads weights file. Returns 'false' if file is
+        /// missing or damaged, leaving previous weights.
+        ///
+        bool load(const std::string& path);
+
+        bool save(const std::string& path) const;
+
+        /// Computes accumulator of the position from scratch.
+        ///
+        void refresh(const Position& position, Accumulator& accumulator) const;
+
+        /// Computes accumulator after the step from the accumulator
+        /// before it. 'position' is the one after make().
+        ///
+        void update(const Accumulator& before, Accumulator& after, const Position& position, const Position::Undo& undo) const;
+
+        /// Returns score of the position for the side to move,
+        /// in the units of evaluate().
+        ///
+        int evaluate(const Accumulator& accumulator, int side) const;
+    };
+}
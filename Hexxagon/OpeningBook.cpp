@@ -0,0 +1,139 @@
+#include "OpeningBook.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Hexxagon
+{
+    namespace
+    {
+        constexpr char Magic[4] = { 'H', 'X', 'B', 'K' };
+        constexpr std::size_t EntrySize = 12;
+
+        void writeLE(char* out, std::uint64_t value, int bytes)
+        {
+            for (int i = 0; i < bytes; i++)
+                out[i] = (char)((value >> (i * 8)) & 0xFF);
+        }
+
+        std::uint64_t readLE(const char* in, int bytes)
+        {
+            std::uint64_t value = 0;
+            for (int i = 0; i < bytes; i++)
+                value |= (std::uint64_t)(unsigned char)in[i] << (i * 8);
+            return value;
+        }
+
+        bool entryLess(const OpeningBook::Entry& a, const OpeningBook::Entry& b)
+        {
+            if (a.key != b.key)
+                return a.key < b.key;
+            return a.move.from != b.move.from ? a.move.from < b.move.from : a.move.to < b.move.to;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool OpeningBook::load(const std::string& path)
+    {
+        entries.clear();
+        std::fstream stream(path, std::ios::in | std::ios::binary);
+        char header[16];
+        if (!stream.read(header, sizeof(header)) || std::memcmp(header, Magic, 4) != 0 || readLE(header + 4, 4) != Version)
+            return false;
+
+        std::uint64_t count = readLE(header + 8, 8);
+        std::vector<char> data(count * EntrySize);
+        if (!stream.read(data.data(), data.size()))
+            return false;
+
+        entries.resize(count);
+        for (std::size_t i = 0; i < count; i++) {
+            const char* in = data.data() + i * EntrySize;
+            entries[i].key = readLE(in, 8);
+            entries[i].move = { (std::uint8_t)in[8], (std::uint8_t)in[9] };
+            entries[i].weight = (std::uint16_t)readLE(in + 10, 2);
+        }
+        if (!std::is_sorted(entries.begin(), entries.end(), entryLess)) {
+            entries.clear();
+            return false;
+        }
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool OpeningBook::save(const std::string& path) const
+    {
+        std::vector<char> data(16 + entries.size() * EntrySize);
+        std::memcpy(data.data(), Magic, 4);
+        writeLE(data.data() + 4, Version, 4);
+        writeLE(data.data() + 8, entries.size(), 8);
+        for (std::size_t i = 0; i < entries.size(); i++) {
+            char* out = data.data() + 16 + i * EntrySize;
+            writeLE(out, entries[i].key, 8);
+            out[8] = (char)entries[i].move.from;
+            out[9] = (char)entries[i].move.to;
+            writeLE(out + 10, entries[i].weight, 2);
+        }
+
+        std::fstream stream(path, std::ios::out | std::ios::trunc | std::ios::binary);
+        return (bool)stream.write(data.data(), data.size());
+    }
+
+    ////////////////////////////////////////////////////////////
+    void OpeningBook::add(std::uint64_t key, Move move, int weight)
+    {
+        entries.push_back({ key, move, (std::uint16_t)std::min(weight, 0xFFFF) });
+    }
+
+    ////////////////////////////////////////////////////////////
+    void OpeningBook::finalize()
+    {
+        std::sort(entries.begin(), entries.end(), entryLess);
+        std::vector<Entry> merged;
+        for (const Entry& entry : entries) {
+            if (!merged.empty() && merged.back().key == entry.key && merged.back().move == entry.move)
+                merged.back().weight = (std::uint16_t)std::min(merged.back().weight + entry.weight, 0xFFFF);
+            else
+                merged.push_back(entry);
+        }
+        std::erase_if(merged, [](const Entry& e) -> bool { return e.weight == 0; });
+        entries = std::move(merged);
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::pair<const OpeningBook::Entry*, const OpeningBook::Entry*> OpeningBook::find(std::uint64_t key) const
+    {
+        auto range = std::equal_range(entries.begin(), entries.end(), Entry{ key, {}, 0 },
+            [](const Entry& a, const Entry& b) -> bool { return a.key < b.key; });
+        return { entries.data() + (range.first - entries.begin()), entries.data() + (range.second - entries.begin()) };
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::optional<Move> OpeningBook::probe(const Position& position, const std::function<unsigned int(unsigned int bound)>& random) const
+    {
+        auto [first, last] = find(position.getHash());
+        if (first == last)
+            return std::nullopt;
+
+        MoveList legal;
+        position.generateMoves(legal);
+        std::vector<const Entry*> candidates;
+        unsigned int total = 0;
+        for (const Entry* entry = first; entry != last; entry++) {
+            if (std::find(legal.begin(), legal.end(), entry->move) != legal.end()) {
+                candidates.push_back(entry);
+                total += entry->weight;
+            }
+        }
+        if (total == 0)
+            return std::nullopt;
+
+        unsigned int pick = random(total);
+        for (const Entry* entry : candidates) {
+            if (pick < entry->weight)
+                return entry->move;
+            pick -= entry->weight;
+        }
+        return candidates.back()->move;
+    }
+}
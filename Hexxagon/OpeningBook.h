@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+#include "Position.h"
+
+namespace Hexxagon
+{
+
+    ////////////////////////////////////////////////////////////
+    /// Opening book: moves played from known positions, with
+    /// weights, which affect how often the move is chosen.
+    ///
+    /// File layout: "HXBK" magic, 32-bit version, 64-bit entry
+    /// count and entries sorted by key, 12 bytes each
+    /// (64-bit key, 'from', 'to', 16-bit weight), little-endian.
+    ////////////////////////////////////////////////////////////
+    class OpeningBook
+    {
+    public:
+        struct Entry
+        {
+            std::uint64_t key = 0;
+            Move move;
+            std::uint16_t weight = 0;
+        };
+
+        static constexpr std::uint32_t Version = 1;
+
+    private:
+        std::vector<Entry> entries;     //!< sorted by key, then by move
+
+    public:
+        /// Reads book file. Returns 'false' if file is
+        /// missing or damaged, leaving book empty.
+        ///
+        bool load(const std::string& path);
+
+        bool save(const std::string& path) const;
+
+        /// Adds weight to the move from the position.
+        /// finalize() has to be called before lookups.
+        ///
+        void add(std::uint64_t key, Move move, int weight);
+
+        /// Sorts entries and merges duplicate moves.
+        ///
+        void finalize();
+
+        /// Returns entries of the position, found by binary search.
+        ///
+        std::pair<const Entry*, const Entry*> find(std::uint64_t key) const;
+
+        /// Picks legal book move of the position, with chance
+        /// proportional to it's weight. 'random' returns value
+        /// in range [0, bound).
+        ///
+        std::optional<Move> probe(const Position& position, const std::function<unsigned int(unsigned int bound)>& random) const;
+
+        std::size_t size() const { return entries.size(); }
+    };
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Hexxagon
+{
+
+    ////////////////////////////////////////////////////////////
+    /// Fixed capacity object pool. Objects are stored in one
+    /// contiguous block, addressed by index and released in
+    /// bulk together with the pool. Storage never reallocates,
+    /// so pointers to pooled objects stay valid.
+    ////////////////////////////////////////////////////////////
+    template<class T>
+    class Pool
+    {
+    private:
+        std::vector<T> items;
+        std::vector<int> released;      //!< indices of released objects, reused by acquire()
+        std::size_t capacity;       //!< as requested, reserve() may allocate more
+
+    public:
+        Pool(std::size_t capacity) : capacity(capacity) { items.reserve(capacity); }
+
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+
+        /// Constructs new object in the pool and returns
+        /// it's index.
+        ///
+        template<class... Args>
+        int acquire(Args&&... args)
+        {
+            if (!released.empty()) {
+                int index = released.back();
+                released.pop_back();
+                items[index] = T(std::forward<Args>(args)...);
+                return index;
+            }
+            if (items.size() == capacity)
+                throw std::length_error("Pool capacity exceeded");
+            items.emplace_back(std::forward<Args>(args)...);
+            return (int)items.size() - 1;
+        }
+
+        /// Marks object as free, so it's slot can be reused.
+        ///
+        void release(int index) { released.push_back(index); }
+
+        /// Releases every object at once.
+        ///
+        void clear()
+        {
+            items.clear();
+            released.clear();
+        }
+
+        std::size_t size() const { return items.size() - released.size(); }      //!< returns count of used objects
+
+        T& operator[](int index) { return items[index]; }
+
+        const T& operator[](int index) const { return items[index]; }
+    };
+}
@@ -0,0 +1,114 @@
+#include "Position.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    Position::Position(const Topology& topology) : topology(&topology)
+    {
+        for (Bitboard start = topology.start(Red); start; )
+            place(start.popFirst(), Red);
+        for (Bitboard start = topology.start(Blue); start; )
+            place(start.popFirst(), Blue);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Position::place(int index, int player)
+    {
+        clear(index);
+        pieces[player].set(index);
+        hash ^= Zobrist.cells[player][index];
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Position::clear(int index)
+    {
+        for (int player : { Red, Blue }) {
+            if (pieces[player].test(index)) {
+                pieces[player].reset(index);
+                hash ^= Zobrist.cells[player][index];
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Position::setSide(int player)
+    {
+        if (side != player)
+            hash ^= Zobrist.side;
+        side = player;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Position::generateMoves(MoveList& moves) const
+    {
+        moves.clear();
+        const Bitboard empty = getEmpty();
+
+        Bitboard clones;
+        for (Bitboard own = pieces[side]; own; ) {
+            int from = own.popFirst();
+            clones |= topology->close(from);
+        }
+        for (clones &= empty; clones; ) {
+            int to = clones.popFirst();
+            moves.push({ (std::uint8_t)to, (std::uint8_t)to });
+        }
+
+        for (Bitboard own = pieces[side]; own; ) {
+            int from = own.popFirst();
+            for (Bitboard jumps = topology->distant(from) & empty; jumps; )
+                moves.push({ (std::uint8_t)from, (std::uint8_t)jumps.popFirst() });
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool Position::hasMoves(int player) const
+    {
+        const Bitboard empty = getEmpty();
+        for (Bitboard own = pieces[player]; own; ) {
+            int from = own.popFirst();
+            if ((topology->close(from) | topology->distant(from)) & empty)
+                return true;
+        }
+        return false;
+    }
+
+    ////////////////////////////////////////////////////////////
+    Position::Undo Position::make(Move move)
+    {
+        Undo undo{ move, topology->close(move.to) & pieces[1 - side], hash };
+
+        pieces[side] |= undo.captured | Bitboard::cell(move.to);
+        pieces[1 - side] ^= undo.captured;
+        hash ^= Zobrist.cells[side][move.to];
+        for (Bitboard captured = undo.captured; captured; ) {
+            int index = captured.popFirst();
+            hash ^= Zobrist.cells[side][index] ^ Zobrist.cells[1 - side][index];
+        }
+        if (!move.isClone()) {
+            pieces[side].reset(move.from);
+            hash ^= Zobrist.cells[side][move.from];
+        }
+
+        side = 1 - side;
+        hash ^= Zobrist.side;
+        return undo;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Position::unmake(const Undo& undo)
+    {
+        side = 1 - side;
+        hash = undo.hash;
+        pieces[side] &= ~(undo.captured | Bitboard::cell(undo.move.to));
+        pieces[1 - side] |= undo.captured;
+        if (!undo.move.isClone())
+            pieces[side].set(undo.move.from);
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool Position::isGameOver() const
+    {
+        return pieces[Red].empty() || pieces[Blue].empty() || getEmpty().empty() || !hasMoves(Red) || !hasMoves(Blue);
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "Bitboard.h"
+#include "Topology.h"
+#include "Zobrist.h"
+
+namespace Hexxagon
+{
+
+    ////////////////////////////////////////////////////////////
+    /// Game step. Clone moves (to the close neighbour cell)
+    /// have 'from' equal to 'to', since the source of the new
+    /// gamechip doesn't affect the position.
+    ////////////////////////////////////////////////////////////
+    struct Move
+    {
+        std::uint8_t from = 0;
+        std::uint8_t to = 0;
+
+        bool isClone() const { return from == to; }
+
+        bool operator==(const Move&) const = default;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Fixed capacity list of moves, kept on the stack.
+    ////////////////////////////////////////////////////////////
+    class MoveList
+    {
+    public:
+        static constexpr int Capacity = 2048;     //!< 127 clones + 12 jumps for each of 127 cells fit in
+
+    private:
+        std::array<Move, Capacity> moves;
+        int count = 0;
+
+    public:
+        void push(Move move) { moves[count++] = move; }
+
+        void clear() { count = 0; }
+
+        int size() const { return count; }
+
+        bool empty() const { return count == 0; }
+
+        Move& operator[](int index) { return moves[index]; }
+
+        const Move& operator[](int index) const { return moves[index]; }
+
+        Move* begin() { return moves.data(); }
+        Move* end() { return moves.data() + count; }
+        const Move* begin() const { return moves.data(); }
+        const Move* end() const { return moves.data() + count; }
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Packed game state without any rendering data: one
+    /// bitboard of gamechips per player and the side to move.
+    ////////////////////////////////////////////////////////////
+    class Position
+    {
+    public:
+        static constexpr int Red = 0;
+        static constexpr int Blue = 1;
+
+        /// Information for unmake(), returned by make().
+        ///
+        struct Undo
+        {
+            Move move;
+            Bitboard captured;
+            std::uint64_t hash;
+        };
+
+    private:
+        const Topology* topology;
+        std::array<Bitboard, 2> pieces{};
+        int side = Red;
+        std::uint64_t hash = 0;     //!< Zobrist hash, updated incrementally
+
+    public:
+        explicit Position(const Topology& topology = Topology::standard());      //!< creates start position of the topology
+
+        /// Setters
+        ///
+        void place(int index, int player);      //!< puts gamechip of the player into cell
+
+        void clear(int index);      //!< removes gamechip from cell
+
+        void setSide(int player);
+
+        /// Getters
+        ///
+        const Topology& getTopology() const { return *topology; }
+
+        int getSide() const { return side; }
+
+        const Bitboard& getPieces(int player) const { return pieces[player]; }
+
+        Bitboard getEmpty() const { return topology->cells() & ~(pieces[Red] | pieces[Blue]); }
+
+        int count(int player) const { return pieces[player].count(); }
+
+        std::uint64_t getHash() const { return hash; }
+
+        /// Generates all moves of the side to move.
+        ///
+        void generateMoves(MoveList& moves) const;
+
+        bool hasMoves(int player) const;        //!< returns 'true' if player can make any step
+
+        /// Makes move of the side to move and captures
+        /// opponent's gamechips around target cell.
+        ///
+        Undo make(Move move);
+
+        void unmake(const Undo& undo);
+
+        /// Returns 'true' if any player has no gamechips or no
+        /// steps, or board is full: the rules GameStatus uses.
+        ///
+        bool isGameOver() const;
+
+        bool operator==(const Position& p) const { return pieces == p.pieces && side == p.side; }
+    };
+}
@@ -0,0 +1,152 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace sf
+{
+	/***********************************************************/
+	/// Profiler class methods initialisation.
+	/***********************************************************/
+	Profiler& Profiler::instance() {
+		static Profiler profiler;
+		return profiler;
+	}
+
+	int Profiler::section(const std::string& name) {
+		auto iter = std::find(names.begin(), names.end(), name);
+		if (iter != names.end())
+			return iter - names.begin();
+		if (names.size() == MaxSections)
+			return MaxSections - 1;		// sections over the limit are summed in the last one
+		names.push_back(name);
+		return names.size() - 1;
+	}
+
+	void Profiler::beginFrame() {
+		if (in_frame)
+			return;
+		in_frame = true;
+		frame_clock.restart();
+		frames[recorded % FrameCount] = Frame{};
+	}
+
+	void Profiler::endFrame() {
+		if (!in_frame)
+			return;
+		Frame& frame = frames[recorded % FrameCount];
+		frame.frame_ms = frame_clock.getElapsedTime().asMicroseconds() / 1000.f;
+		if (input_pending) {
+			frame.latency_ms = input_clock.getElapsedTime().asMicroseconds() / 1000.f;
+			input_pending = false;
+		}
+		recorded++;
+		in_frame = false;
+	}
+
+	void Profiler::inputReceived() {
+		if (!input_pending) {
+			input_pending = true;
+			input_clock.restart();
+		}
+	}
+
+	void Profiler::addTime(int section, Time time) {
+		if (in_frame)
+			frames[recorded % FrameCount].sections[section] += time.asMicroseconds() / 1000.f;
+	}
+
+	const Profiler::Frame& Profiler::getFrame(int ago) const {
+		return frames[(recorded - 1 - ago + FrameCount) % FrameCount];
+	}
+
+	int Profiler::getFrameCount() const { return std::min(recorded, FrameCount); }
+
+	const std::vector<std::string>& Profiler::getSectionNames() const { return names; }
+
+	bool Profiler::dump(const std::string& path) const {
+		std::fstream stream(path, std::ios::out | std::ios::trunc);
+		if (!stream.is_open())
+			return false;
+
+		stream << "frame_ms,latency_ms";
+		for (const std::string& name : names)
+			stream << "," << name;
+		stream << "\n";
+
+		for (int ago = getFrameCount() - 1; ago >= 0; ago--) {
+			const Frame& frame = getFrame(ago);
+			stream << frame.frame_ms << "," << frame.latency_ms;
+			for (std::size_t i = 0; i < names.size(); i++)
+				stream << "," << frame.sections[i];
+			stream << "\n";
+		}
+		return (bool)stream;
+	}
+
+
+	/***********************************************************/
+	/// ProfilerOverlay class methods initialisation.
+	/***********************************************************/
+	ProfilerOverlay::ProfilerOverlay(const Profiler& profiler, const Font& font) : profiler(profiler), text(font, "", 16) {
+		text.setPosition({ 0.f, GraphHeight + 5.f });
+	}
+
+	void ProfilerOverlay::draw(RenderTarget& target, const RenderStates& states) const {
+		const int count = profiler.getFrameCount();
+		graph.clear();
+
+		/////////////////////////////////////////////////////////
+		/// Bar per frame, newest on the right, and a line
+		/// at 16.7 ms
+		/////////////////////////////////////////////////////////
+		auto quad = [this](float left, float top, float width, float height, Color color) {
+			Vector2f a{ left, top }, b{ left + width, top }, c{ left + width, top + height }, d{ left, top + height };
+			for (Vector2f point : { a, b, c, a, c, d })
+				graph.append(Vertex{ point, color });
+		};
+		quad(0, 0, Profiler::FrameCount, GraphHeight, Color(0, 0, 0, 160));
+		for (int ago = 0; ago < count; ago++) {
+			const Profiler::Frame& frame = profiler.getFrame(ago);
+			float height = std::min(frame.frame_ms * MsHeight, GraphHeight);
+			Color color = frame.frame_ms > 16.7f ? Color(227, 38, 54) : Color(80, 200, 80);
+			quad(Profiler::FrameCount - 1.f - ago, GraphHeight - height, 1, height, color);
+		}
+		quad(0, GraphHeight - 16.7f * MsHeight, Profiler::FrameCount, 1, Color(255, 255, 255, 120));
+
+		/////////////////////////////////////////////////////////
+		/// Sections sorted by their slowest frame
+		/////////////////////////////////////////////////////////
+		const std::vector<std::string>& names = profiler.getSectionNames();
+		std::vector<std::pair<float, float>> totals(names.size());		// max, sum
+		float max_frame = 0, max_latency = 0, sum_frame = 0;
+		for (int ago = 0; ago < count; ago++) {
+			const Profiler::Frame& frame = profiler.getFrame(ago);
+			max_frame = std::max(max_frame, frame.frame_ms);
+			max_latency = std::max(max_latency, frame.latency_ms);
+			sum_frame += frame.frame_ms;
+			for (std::size_t i = 0; i < names.size(); i++) {
+				totals[i].first = std::max(totals[i].first, frame.sections[i]);
+				totals[i].second += frame.sections[i];
+			}
+		}
+		std::vector<std::size_t> order(names.size());
+		for (std::size_t i = 0; i < order.size(); i++)
+			order[i] = i;
+		std::sort(order.begin(), order.end(), [&totals](std::size_t a, std::size_t b) -> bool { return totals[a].first > totals[b].first; });
+
+		std::ostringstream str;
+		str << std::fixed << std::setprecision(2)
+			<< "frame avg " << (count > 0 ? sum_frame / count : 0.f) << " max " << max_frame << " ms\n"
+			<< "input latency max " << max_latency << " ms\n";
+		for (std::size_t i : order)
+			str << names[i] << ": max " << totals[i].first << " avg " << (count > 0 ? totals[i].second / count : 0.f) << " ms\n";
+		text.setString(str.str());
+
+		RenderStates overlay_states = states;
+		overlay_states.transform *= getTransform();
+		target.draw(graph, overlay_states);
+		target.draw(text, overlay_states);
+	}
+}
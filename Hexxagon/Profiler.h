@@ -0,0 +1,104 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <string>
+#include <vector>
+
+namespace sf
+{
+	/// Timings of the render loop: each frame stores time of
+	/// the frame, input latency and time spent in every section.
+	/// Last FrameCount frames are kept in a ring buffer.
+	///
+	/// Frame starts when FramePacer stops waiting for events and
+	/// ends when it displays the frame, so idle time is not counted.
+	/// Sections may be nested and their times are inclusive.
+	///
+	class Profiler {
+	public:
+		static constexpr int MaxSections = 12;
+		static constexpr int FrameCount = 240;
+
+		struct Frame {
+			float frame_ms = 0;
+			float latency_ms = 0;		//!< time from the first input event to display, 0 if frame handled no input
+			std::array<float, MaxSections> sections{};
+		};
+
+	private:
+		std::vector<std::string> names;
+		std::array<Frame, FrameCount> frames{};
+		int recorded = 0;		//!< count of finished frames
+
+		Clock frame_clock;
+		bool in_frame = false;
+
+		Clock input_clock;
+		bool input_pending = false;
+
+		Profiler() {};
+
+	public:
+		Profiler(const Profiler&) = delete;
+		Profiler& operator=(const Profiler&) = delete;
+
+		static Profiler& instance();
+
+		/// Returns id of the section with the name, registering
+		/// it on first call. Ids are meant to be kept in statics.
+		///
+		int section(const std::string& name);
+
+		void beginFrame();		//!< does nothing if frame is already started
+
+		void endFrame();
+
+		void inputReceived();		//!< starts latency measurement, if it is not running
+
+		void addTime(int section, Time time);
+
+		/// Returns frame finished 'ago' frames before the last one.
+		///
+		const Frame& getFrame(int ago) const;
+
+		int getFrameCount() const;		//!< returns count of stored frames
+
+		const std::vector<std::string>& getSectionNames() const;
+
+		/// Writes stored frames to CSV file, oldest first.
+		///
+		bool dump(const std::string& path) const;
+	};
+
+	/// Adds time of it's lifetime to the profiler section.
+	///
+	class ProfileScope {
+	private:
+		int section;
+		Clock clock;
+
+	public:
+		explicit ProfileScope(int section) : section(section) {}
+
+		~ProfileScope() { Profiler::instance().addTime(section, clock.getElapsedTime()); }
+	};
+
+	/// Frame time graph and slowest sections of the profiler.
+	///
+	class ProfilerOverlay : public Drawable, public Transformable {
+	private:
+		const Profiler& profiler;
+
+		mutable VertexArray graph{ PrimitiveType::Triangles };
+		mutable Text text;
+
+		static constexpr float GraphHeight = 100.f;
+		static constexpr float MsHeight = 3.f;		//!< graph height of 1 millisecond
+
+		void draw(RenderTarget& target, const RenderStates& states) const override;
+
+	public:
+		ProfilerOverlay(const Profiler& profiler, const Font& font);
+	};
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include "Position.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    /// Message of the network game protocol. Every message is
+    /// Size bytes: type and two arguments, so TCP stream needs
+    /// no other framing.
+    ///
+    /// Client sends Join once and then Step for own moves.
+    /// Server answers Start with the side of the client, relays
+    /// valid steps to the opponent and ends game with GameOver
+    /// or Left, if the opponent has disconnected. Server, which
+    /// can't take more games against computer, answers Busy.
+    ////////////////////////////////////////////////////////////
+    struct Message
+    {
+        static constexpr int Size = 3;
+        static constexpr std::uint8_t Version = 1;
+
+        static constexpr std::uint8_t Human = 0;        //!< Join opponent: next client in the queue
+        static constexpr std::uint8_t Computer = 1;     //!< Join opponent: computer of server's difficulty
+        static constexpr std::uint8_t ComputerLevel = 2;        //!< Join opponent: ComputerLevel + N is computer of difficulty N
+
+        enum Type : std::uint8_t
+        {
+            Join = 1,       //!< a - protocol version, b - opponent: Human, Computer or ComputerLevel + difficulty
+            Start,          //!< a - side of the receiver
+            Step,           //!< a - source cell, b - target cell
+            Rejected,       //!< step was not valid, a and b - the step
+            GameOver,       //!< a - winner: 0 - red, 1 - blue, 2 - draw
+            Left,           //!< opponent has disconnected
+            Busy,           //!< server is saturated, try later
+        };
+
+        Type type = Join;
+        std::uint8_t a = 0;
+        std::uint8_t b = 0;
+
+        static Message step(Move move) { return { Step, move.from, move.to }; }
+
+        Move getMove() const { return { a, b }; }
+
+        void write(std::uint8_t* out) const
+        {
+            out[0] = type;
+            out[1] = a;
+            out[2] = b;
+        }
+
+        /// Returns nothing for unknown message types.
+        ///
+        static std::optional<Message> read(const std::uint8_t* in)
+        {
+            if (in[0] < Join || in[0] > Busy)
+                return std::nullopt;
+            return Message{ (Type)in[0], in[1], in[2] };
+        }
+    };
+}
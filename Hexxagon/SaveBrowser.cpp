@@ -0,0 +1,171 @@
+#include "SaveBrowser.h"
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace sf
+{
+	SaveBrowser::SaveBrowser(Vector2f size, const Font& font, const Hexxagon::Topology& topology) :
+		font(font), topology(topology), size(size), thumbnails(topology, unsigned(RowHeight) - 6), frame(size), highlight({ size.x, RowHeight }) {
+		frame.setFillColor(Color::Black);
+		frame.setOutlineColor(Color::White);
+		frame.setOutlineThickness(3);
+		highlight.setFillColor(Color(60, 60, 120));
+	}
+
+	int SaveBrowser::rowsInView() const {
+		return std::max(1, int(size.y / RowHeight));
+	}
+
+	int SaveBrowser::rowAt(RenderWindow& window) const {
+		Vector2f point = window.mapPixelToCoords(Mouse::getPosition(window)) - getPosition();
+		if (point.x < 0 || point.y < 0 || point.x > size.x || point.y > size.y)
+			return -1;
+		int row = first + int(point.y / RowHeight);
+		return row < int(shown.size()) ? row : -1;
+	}
+
+	void SaveBrowser::scrollTo(int row) {
+		const int max_first = std::max(0, int(shown.size()) - rowsInView());
+		if (row < first)
+			first = row;
+		else if (row >= first + rowsInView())
+			first = row - rowsInView() + 1;
+		first = std::clamp(first, 0, max_first);
+		rebuild();
+	}
+
+	void SaveBrowser::rebuild() {
+		changed = true;
+		labels.clear();
+		icons.clear();
+		const int last = std::min(int(shown.size()), first + rowsInView());
+		for (int row = first; row < last; row++) {
+			const Hexxagon::SaveInfo& info = entries[shown[row]];
+			const float top = (row - first) * RowHeight;
+
+			std::time_t time = info.time;
+			std::ostringstream details;
+			details << std::put_time(std::localtime(&time), "%d.%m.%Y %H:%M")
+				<< "    " << (info.side == Hexxagon::Position::Red ? "Red" : "Blue") << " to move"
+				<< "    " << info.count(Hexxagon::Position::Red) << " : " << info.count(Hexxagon::Position::Blue)
+				<< (info.AI_game ? "    vs computer" : "");
+
+			if (const Texture* texture = thumbnails.get(info.toPosition(topology))) {
+				RectangleShape& icon = icons.emplace_back(Vector2f(texture->getSize()));
+				icon.setTexture(texture);
+				icon.setPosition({ 6.f, top + 3.f });
+			}
+
+			Text& name = labels.emplace_back(font, info.name, 26);
+			name.setPosition({ RowHeight + 10.f, top + 2.f });
+			Text& line = labels.emplace_back(font, details.str(), 18);
+			line.setFillColor(Color(180, 180, 180));
+			line.setPosition({ RowHeight + 10.f, top + 34.f });
+		}
+	}
+
+	void SaveBrowser::draw(RenderTarget& target, const RenderStates& states) const {
+		RenderStates local = states;
+		local.transform *= getTransform();
+		target.draw(frame, local);
+		if (selected >= first && selected < first + rowsInView()) {
+			RenderStates row = local;
+			row.transform.translate({ 0.f, (selected - first) * RowHeight });
+			target.draw(highlight, row);
+		}
+		for (const RectangleShape& icon : icons)
+			target.draw(icon, local);
+		for (const Text& label : labels)
+			target.draw(label, local);
+	}
+
+	void SaveBrowser::handleEvent(RenderWindow& window, const Event& event) {
+		if (event.type == Event::MouseWheelScrolled) {
+			Vector2f point = window.mapPixelToCoords(Mouse::getPosition(window)) - getPosition();
+			if (point.x < 0 || point.y < 0 || point.x > size.x || point.y > size.y)
+				return;
+			const int max_first = std::max(0, int(shown.size()) - rowsInView());
+			first = std::clamp(first - int(event.mouseWheelScroll.delta), 0, max_first);
+			rebuild();
+		}
+		else if (event.type == Event::MouseButtonPressed && event.mouseButton.button == Mouse::Left) {
+			int row = rowAt(window);
+			if (row < 0)
+				return;
+			picked = row == selected;
+			selected = row;
+			changed = true;
+		}
+		else if (event.type == Event::KeyPressed && !shown.empty()) {
+			int step = 0;
+			switch (event.key.code) {
+			case Keyboard::Up: step = -1; break;
+			case Keyboard::Down: step = 1; break;
+			case Keyboard::PageUp: step = -rowsInView(); break;
+			case Keyboard::PageDown: step = rowsInView(); break;
+			default: return;
+			}
+			selected = std::clamp(selected + step, 0, int(shown.size()) - 1);
+			scrollTo(selected);
+		}
+	}
+
+	bool SaveBrowser::update() {
+		if (!thumbnails.update())
+			return false;
+		rebuild();
+		return true;
+	}
+
+	bool SaveBrowser::isLoading() {
+		return thumbnails.isBusy();
+	}
+
+	void SaveBrowser::setEntries(std::vector<Hexxagon::SaveInfo> entries) {
+		this->entries = std::move(entries);
+		filter.clear();
+		refilter();
+	}
+
+	void SaveBrowser::setFilter(const std::string& text) {
+		if (text == filter)
+			return;
+		filter = text;
+		refilter();
+	}
+
+	void SaveBrowser::refilter() {
+		shown.clear();
+		for (int i = 0; i < entries.size(); i++) {
+			if (entries[i].name.find(filter) != std::string::npos)
+				shown.push_back(i);
+		}
+		first = 0;
+		selected = shown.empty() || filter.empty() ? -1 : 0;
+		rebuild();
+	}
+
+	const Hexxagon::SaveInfo* SaveBrowser::getSelected() const {
+		return selected < 0 ? nullptr : &entries[shown[selected]];
+	}
+
+	Vector2f SaveBrowser::getSize() const {
+		return size;
+	}
+
+	bool SaveBrowser::wasPicked() {
+		if (picked) {
+			return !(picked = false);
+		}
+		return picked;
+	}
+
+	bool SaveBrowser::wasChanged() {
+		if (changed) {
+			return !(changed = false);
+		}
+		return changed;
+	}
+}
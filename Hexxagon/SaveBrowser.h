@@ -0,0 +1,83 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "SaveIndex.h"
+#include "Thumbnails.h"
+
+namespace sf
+{
+	/// Scrollable list of saves for the continue screen.
+	/// Only rows in view are turned into Text and thumbnails,
+	/// so the list stays cheap with thousands of entries.
+	///
+	class SaveBrowser : public Drawable, public Transformable {
+	public:
+		static constexpr float RowHeight = 60.f;
+
+	private:
+		const Font& font;
+		const Hexxagon::Topology& topology;
+		Vector2f size;
+		ThumbnailRenderer thumbnails;
+
+		std::vector<Hexxagon::SaveInfo> entries;
+		std::vector<int> shown;		//!< indices of entries, which match the filter
+		std::string filter;
+
+		int first = 0;		//!< index in 'shown' of the top row
+		int selected = -1;		//!< index in 'shown' of the selected row, -1 if none
+
+		bool picked = false;
+		bool changed = false;
+
+		RectangleShape frame;
+		RectangleShape highlight;
+		std::vector<Text> labels;		//!< two lines per row in view
+		std::vector<RectangleShape> icons;		//!< thumbnails of rows in view, which are rendered already
+
+		int rowsInView() const;
+
+		int rowAt(RenderWindow& window) const;		//!< returns index in 'shown' under the mouse, -1 if none
+
+		void scrollTo(int row);		//!< scrolls so that row is in view
+
+		void rebuild();		//!< recreates labels of the rows in view
+
+		void refilter();		//!< collects entries matching the filter and scrolls to the top
+
+		void draw(RenderTarget& target, const RenderStates& states) const override;
+
+	public:
+		SaveBrowser(Vector2f size, const Font& font, const Hexxagon::Topology& topology);
+
+		/// Basic event handling: wheel scrolls, click selects
+		/// and click on selected row picks it.
+		///
+		void handleEvent(RenderWindow& window, const Event& event);
+
+		/// Shows thumbnails rendered since last call. Returns
+		/// 'true' if list look has changed.
+		///
+		bool update();
+
+		bool isLoading();		//!< returns 'true' while thumbnails of rows in view are being rendered
+
+		/// Setters
+		///
+		void setEntries(std::vector<Hexxagon::SaveInfo> entries);
+
+		void setFilter(const std::string& text);		//!< shows only saves, which names contain text
+
+		/// Getters
+		///
+		const Hexxagon::SaveInfo* getSelected() const;		//!< returns nullptr if nothing is selected
+
+		Vector2f getSize() const;
+
+		bool wasPicked();		//!< returns 'true' if selected row was picked since last call
+
+		bool wasChanged();		//!< returns 'true' if list look has changed since last call
+	};
+}
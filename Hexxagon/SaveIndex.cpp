@@ -0,0 +1,190 @@
+#include "SaveIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include "IoWorker.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    std::optional<SaveInfo> SaveInfo::parse(const std::string& name, std::istream& stream, const Topology& topology)
+    {
+        SaveInfo info;
+        info.name = name;
+
+        int header[9];
+        for (int& value : header)
+            stream >> value;
+        info.side = header[7] == 0 ? Position::Red : Position::Blue;
+        info.AI_game = header[8];
+
+        unsigned int field_status = 0;
+        for (int i = 0; i < topology.rows(); i++) {
+            for (int j = 0; j < topology.rowLength(i); j++) {
+                stream >> field_status;
+                int index = topology.index(i, j);
+                if (index >= 0 && field_status & 0b100)
+                    info.pieces[field_status & 0b10 ? Position::Blue : Position::Red].set(index);
+            }
+        }
+        if (!stream)
+            return std::nullopt;
+        return info;
+    }
+
+    ////////////////////////////////////////////////////////////
+    Position SaveInfo::toPosition(const Topology& topology) const
+    {
+        Position position(topology);
+        for (int i = 0; i < topology.cellCount(); i++) {
+            if (pieces[Position::Red].test(i))
+                position.place(i, Position::Red);
+            else if (pieces[Position::Blue].test(i))
+                position.place(i, Position::Blue);
+            else
+                position.clear(i);
+        }
+        position.setSide(side);
+        return position;
+    }
+
+    ////////////////////////////////////////////////////////////
+    SaveIndex& SaveIndex::instance()
+    {
+        static SaveIndex index;
+        return index;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void SaveIndex::load()
+    {
+        std::vector<SaveInfo> loaded;
+        std::fstream stream(IndexPath, std::ios::in);
+        std::string magic;
+        int version = 0;
+        if (stream >> magic >> version && magic == "HXSI" && version == Version) {
+            SaveInfo info;
+            while (stream >> std::quoted(info.name) >> info.time >> info.stamp >> info.size >> info.side >> info.AI_game
+                >> info.pieces[0].lo >> info.pieces[0].hi >> info.pieces[1].lo >> info.pieces[1].hi)
+                loaded.push_back(info);
+        }
+
+        std::lock_guard lock(mutex);
+        entries = std::move(loaded);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void SaveIndex::store()
+    {
+        std::ostringstream stream;
+        stream << "HXSI " << Version << '\n';
+        for (const SaveInfo& info : entries) {
+            stream << std::quoted(info.name) << ' ' << info.time << ' ' << info.stamp << ' ' << info.size << ' '
+                << info.side << ' ' << info.AI_game << ' '
+                << info.pieces[0].lo << ' ' << info.pieces[0].hi << ' ' << info.pieces[1].lo << ' ' << info.pieces[1].hi << '\n';
+        }
+        IoWorker::instance().write(IndexPath, stream.str());
+    }
+
+    ////////////////////////////////////////////////////////////
+    void SaveIndex::sort()
+    {
+        std::ranges::sort(entries, [](const SaveInfo& a, const SaveInfo& b) -> bool {
+            return a.time != b.time ? a.time > b.time : a.name < b.name;
+        });
+    }
+
+    ////////////////////////////////////////////////////////////
+    void SaveIndex::scan(const Topology& topology)
+    {
+        wait();
+        scanning = std::async(std::launch::async, [this, &topology]() {
+            IoWorker::instance().flush();
+            load();
+
+            std::map<std::string, SaveInfo> known;
+            {
+                std::lock_guard lock(mutex);
+                for (SaveInfo& info : entries)
+                    known.emplace(info.name, std::move(info));
+            }
+
+            std::vector<SaveInfo> scanned;
+            std::size_t reused = 0;
+            std::error_code error;
+            for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(Directory, error)) {
+                if (!entry.is_regular_file(error) || entry.path().extension() != ".bin")
+                    continue;
+                std::string name = entry.path().stem().string();
+                std::uintmax_t size = entry.file_size(error);
+                std::filesystem::file_time_type write_time = entry.last_write_time(error);
+                if (error)
+                    continue;
+
+                std::int64_t stamp = write_time.time_since_epoch().count();
+                auto iter = known.find(name);
+                if (iter != known.end() && iter->second.stamp == stamp && iter->second.size == size) {
+                    scanned.push_back(std::move(iter->second));
+                    reused++;
+                    continue;
+                }
+
+                std::fstream stream(entry.path(), std::ios::in | std::ios::binary);
+                std::optional<SaveInfo> info = SaveInfo::parse(name, stream, topology);
+                if (!info)
+                    continue;       // not a save of this board, skipped
+                info->stamp = stamp;
+                info->size = size;
+                info->time = std::chrono::duration_cast<std::chrono::seconds>(
+                    std::chrono::file_clock::to_sys(write_time).time_since_epoch()).count();
+                scanned.push_back(std::move(*info));
+            }
+
+            std::lock_guard lock(mutex);
+            bool changed = reused != known.size() || reused != scanned.size();
+            entries = std::move(scanned);
+            sort();
+            if (changed)
+                store();
+        });
+    }
+
+    ////////////////////////////////////////////////////////////
+    void SaveIndex::wait()
+    {
+        if (scanning.valid())
+            scanning.wait();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void SaveIndex::update(const std::string& name, const Position& position, bool AI_game, std::uintmax_t size)
+    {
+        wait();
+        SaveInfo info;
+        info.name = name.ends_with(".bin") ? name.substr(0, name.size() - 4) : name;
+        info.time = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        info.stamp = 0;     // write time is known only after IoWorker wrote the file, next scan reads it again
+        info.size = size;
+        info.side = position.getSide();
+        info.AI_game = AI_game;
+        info.pieces[0] = position.getPieces(Position::Red);
+        info.pieces[1] = position.getPieces(Position::Blue);
+
+        std::lock_guard lock(mutex);
+        std::erase_if(entries, [&info](const SaveInfo& entry) -> bool { return entry.name == info.name; });
+        entries.insert(entries.begin(), std::move(info));
+        store();
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::vector<SaveInfo> SaveIndex::getEntries()
+    {
+        wait();
+        std::lock_guard lock(mutex);
+        return entries;
+    }
+}
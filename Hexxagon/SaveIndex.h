@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <istream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include "Position.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    /// Metadata of one save file, enough to list it without
+    /// opening the file: the pieces double as a thumbnail.
+    ////////////////////////////////////////////////////////////
+    struct SaveInfo
+    {
+        std::string name;       //!< file name without "Saves\" and ".bin"
+        std::int64_t time = 0;      //!< seconds since epoch, when game was saved
+        std::int64_t stamp = 0;     //!< file write time in file clock ticks, 0 if not known yet
+        std::uintmax_t size = 0;        //!< file size in bytes
+        int side = Position::Red;       //!< side to move
+        bool AI_game = false;
+        Bitboard pieces[2];
+
+        int count(int player) const { return pieces[player].count(); }
+
+        Position toPosition(const Topology& topology) const;
+
+        /// Reads save file contents written by Board::save().
+        /// Returns nothing if the file doesn't fit the topology.
+        ///
+        static std::optional<SaveInfo> parse(const std::string& name, std::istream& stream, const Topology& topology);
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Cached list of save files, kept in "Saves\index.txt".
+    ///
+    /// Startup scan only stats the directory and reads files,
+    /// which were added or changed since the index was written,
+    /// so the save browser opens at once with thousands of saves.
+    /// Board::save() updates the entry in place.
+    ////////////////////////////////////////////////////////////
+    class SaveIndex
+    {
+    public:
+        static constexpr const char* Directory = "Saves";
+        static constexpr const char* IndexPath = "Saves\\index.txt";
+        static constexpr int Version = 1;
+
+    private:
+        std::mutex mutex;
+        std::vector<SaveInfo> entries;      //!< sorted by save time, newest first
+        std::future<void> scanning;     //!< background scan started by scan()
+
+        SaveIndex() {};
+
+        void load();        //!< reads index file into entries
+
+        void store();       //!< queues index file write to IoWorker
+
+        void sort();
+
+    public:
+        SaveIndex(const SaveIndex&) = delete;
+        SaveIndex& operator=(const SaveIndex&) = delete;
+
+        static SaveIndex& instance();
+
+        /// Starts background scan of the save directory against
+        /// the index file. Saves have to use the topology.
+        ///
+        void scan(const Topology& topology = Topology::standard());
+
+        void wait();        //!< blocks until background scan is finished
+
+        /// Records save, which was just queued for writing.
+        ///
+        void update(const std::string& name, const Position& position, bool AI_game, std::uintmax_t size);
+
+        /// Returns copy of all entries, newest first. Waits for
+        /// the scan, if it is still running.
+        ///
+        std::vector<SaveInfo> getEntries();
+    };
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GameBoard.h"
+
+/// Class for recording game info
+/// into file.
+/// 
+class ScoreRec : public sf::Text {
+private:
+	std::string nickname;
+	int score;
+	int points;
+	std::string time;
+
+	void verify() {
+		if (score < 0)
+			score = 0;
+		if (points < 0)
+			points = 0;
+	}
+public:
+	ScoreRec(std::string input, const sf::Font& font) : sf::Text(font, "", 50) {
+		auto str_input = std::stringstream(input);
+		std::getline(str_input, nickname, '_');
+		std::string buff;
+		std::getline(str_input, buff, ';');
+		score = std::stoi(buff);
+		std::getline(str_input, buff, '|');
+		points = std::stoi(buff);
+		str_input >> time;
+		verify();
+
+		setString(nickname + " - " + std::to_string(score) + " (" + std::to_string(points) + " points) " + time);
+	}
+
+	ScoreRec(Hexxagon::Board::GameStatus* status, const sf::Font& font) : sf::Text(font, "", 50)
+	{
+		bool red_won = status->getRedPoints() > status->getBluePoints();
+		if (red_won) {
+			nickname = "Red";
+			score = status->getRedScore();
+			points = status->getRedPoints();
+		}
+		else {
+			nickname = "Blue";
+			score = status->getBlueScore();
+			points = status->getBluePoints();
+		}
+		time = status->getTime();
+
+		verify();
+		setString(nickname + " - " + std::to_string(score) + " (" + std::to_string(points) + ")");
+	}
+
+	/// Basic file read logic, which returns
+	/// std::vector of saved scores info.
+	///
+	static std::vector<ScoreRec> read_file(std::fstream& stream, const sf::Font& font) {
+		std::vector<ScoreRec> v;
+		std::string buff;
+		while (std::getline(stream, buff)) {
+			v.emplace_back(buff, font);
+		}
+		return v;
+	};
+
+	/// Basic file write logic, which writes info
+	/// from std::vector of ScoreRec objects.
+	///
+	static void write_file(std::vector<ScoreRec> v, std::string file_path) {
+		std::ostringstream stream;
+		for (ScoreRec elem : v) {
+			stream << elem << '\n';
+		}
+		Hexxagon::IoWorker::instance().write(file_path, stream.str());
+	};
+
+	/// Score table sorting.
+	///
+	static void sort(std::vector<ScoreRec>& v) {
+		if (v.size() > 0) {
+			for (int i = 0; i < v.size(); i++) {
+				for (int j = i + 1; j < v.size(); j++) {
+					if (v[i] < v[j]) {
+						ScoreRec buff = v[i];
+						v[i] = v[j];
+						v[j] = buff;
+					}
+				}
+			}
+		}
+	}
+
+	/// Getters
+	///
+	std::string getNickname() const {
+		return nickname;
+	}
+
+	int getScore() const {
+		return score;
+	}
+
+	int getPoints() const {
+		return points;
+	}
+
+	/// Operators
+	///
+	friend std::ostream& operator <<(std::fstream& fstream, const ScoreRec& score_obj) {
+		return fstream << score_obj.nickname << "_" << score_obj.score << ';' << score_obj.points << "|" << score_obj.time;
+	}
+	friend std::ostream& operator <<(std::ostream& fstream, const ScoreRec& score_obj) {
+		return fstream << score_obj.nickname << "_" << score_obj.score << ';' << score_obj.points << "|" << score_obj.time;
+	}
+
+	friend bool operator <(ScoreRec& score_1, ScoreRec& score_2) {
+		return score_1.score < score_2.score;
+	}
+
+	friend bool operator >(ScoreRec& score_1, ScoreRec& score_2) {
+		return score_1.score > score_2.score;
+	}
+};
@@ -0,0 +1,244 @@
+#include "Search.h"
+#include <algorithm>
+#include "Zobrist.h"
+
+namespace Hexxagon
+{
+    /***********************************************************/
+    /// TranspositionTable class methods initialisation.
+    /***********************************************************/
+    TranspositionTable::TranspositionTable(std::size_t megabytes)
+    {
+        std::size_t count = 1;
+        while (count * 2 * sizeof(Entry) <= megabytes * 1024 * 1024)
+            count *= 2;
+        entries.resize(count);
+        mask = count - 1;
+    }
+
+    ////////////////////////////////////////////////////////////
+    const TranspositionTable::Entry* TranspositionTable::probe(std::uint64_t key) const
+    {
+        const Entry& entry = entries[key & mask];
+        return entry.bound != None && entry.key == key ? &entry : nullptr;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void TranspositionTable::store(std::uint64_t key, int score, int depth, Bound bound, Move move)
+    {
+        Entry& entry = entries[key & mask];
+        if (entry.key == key && entry.depth > depth && bound != Exact)
+            return;
+        entry = { key, (std::int16_t)score, (std::int8_t)depth, bound, move };
+    }
+
+    ////////////////////////////////////////////////////////////
+    void TranspositionTable::clear() { std::fill(entries.begin(), entries.end(), Entry{}); }
+
+
+    /***********************************************************/
+    /// Search class methods initialisation.
+    /***********************************************************/
+    Search::Search(std::size_t table_megabytes) : table(table_megabytes) {}
+
+    ////////////////////////////////////////////////////////////
+    void Search::setWeights(const EvalWeights& weights) { this->weights = weights; }
+
+    ////////////////////////////////////////////////////////////
+    void Search::setNetwork(const Network* network)
+    {
+        this->network = network;
+        accumulators.resize(network != nullptr ? SearchLimits::MaxDepth + 1 : 0);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Search::clear() { table.clear(); }
+
+    ////////////////////////////////////////////////////////////
+    void Search::setNoise(int amplitude, std::uint64_t seed)
+    {
+        noise = amplitude;
+        noise_key = amplitude != 0 ? splitmix64(seed) | 1 : 0;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Search::setInfoCallback(std::function<void(const SearchStats&)> callback) { on_iteration = std::move(callback); }
+
+    ////////////////////////////////////////////////////////////
+    const SearchStats& Search::getStats() const { return stats; }
+
+    ////////////////////////////////////////////////////////////
+    int Search::evaluateLeaf(const Position& position, int ply) const
+    {
+        int score = network == nullptr ? evaluate(position, weights) : network->evaluate(accumulators[ply], position.getSide());
+        if (noise != 0) {
+            std::uint64_t state = tableKey(position);
+            score += (int)(splitmix64(state) % (2 * noise + 1)) - noise;
+        }
+        return std::clamp(score, -WinScore + 1, WinScore - 1);
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool Search::outOfLimits()
+    {
+        if (limits.nodes != 0 && stats.nodes >= limits.nodes)
+            stopped = true;
+        else if (limits.milliseconds != 0 && (stats.nodes & 1023) == 0 &&
+            std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(limits.milliseconds))
+            stopped = true;
+        else if (limits.stop != nullptr && (stats.nodes & 1023) == 0 && *limits.stop)
+            stopped = true;
+        return stopped;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Search::scoreMoves(const Position& position, const MoveList& moves, Move hash_move, int* scores) const
+    {
+        const Topology& topology = position.getTopology();
+        const Bitboard& opponent = position.getPieces(1 - position.getSide());
+        for (int i = 0; i < moves.size(); i++) {
+            const Move& move = moves[i];
+            if (move == hash_move)
+                scores[i] = 1 << 20;
+            else
+                scores[i] = (topology.close(move.to) & opponent).count() * 4 + (move.isClone() ? 2 : 0);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    int Search::alphaBeta(Position& position, int depth, int alpha, int beta, int ply)
+    {
+        stats.nodes++;
+        if (position.isGameOver())
+            return finalScore(position);
+        if (depth <= 0)
+            return evaluateLeaf(position, ply);
+
+        const int original_alpha = alpha;
+        Move hash_move{ 0, 0 };
+        stats.table_probes++;
+        if (const TranspositionTable::Entry* entry = table.probe(tableKey(position))) {
+            stats.table_hits++;
+            hash_move = entry->move;
+            if (ply > 0 && entry->depth >= depth) {
+                if (entry->bound == TranspositionTable::Exact)
+                    return entry->score;
+                if (entry->bound == TranspositionTable::Lower && entry->score >= beta)
+                    return entry->score;
+                if (entry->bound == TranspositionTable::Upper && entry->score <= alpha)
+                    return entry->score;
+            }
+        }
+
+        MoveList moves;
+        position.generateMoves(moves);
+        int scores[MoveList::Capacity];
+        scoreMoves(position, moves, hash_move, scores);
+
+        int best_score = -WinScore * 2;
+        Move best_move = moves[0];
+        for (int i = 0; i < moves.size(); i++) {
+            // selection sort step: bring the best of remaining moves forward
+            int best_index = i;
+            for (int j = i + 1; j < moves.size(); j++)
+                if (scores[j] > scores[best_index])
+                    best_index = j;
+            std::swap(moves[i], moves[best_index]);
+            std::swap(scores[i], scores[best_index]);
+
+            Position::Undo undo = position.make(moves[i]);
+            if (network != nullptr)
+                network->update(accumulators[ply], accumulators[ply + 1], position, undo);
+            int score = -alphaBeta(position, depth - 1, -beta, -alpha, ply + 1);
+            position.unmake(undo);
+
+            if (outOfLimits())
+                return 0;
+
+            if (score > best_score) {
+                best_score = score;
+                best_move = moves[i];
+                if (ply == 0)
+                    root_move = best_move;
+                if (score > alpha)
+                    alpha = score;
+                if (alpha >= beta) {
+                    stats.cutoffs++;
+                    if (i == 0)
+                        stats.first_move_cutoffs++;
+                    break;
+                }
+            }
+        }
+
+        TranspositionTable::Bound bound = best_score <= original_alpha ? TranspositionTable::Upper :
+            best_score >= beta ? TranspositionTable::Lower : TranspositionTable::Exact;
+        table.store(tableKey(position), best_score, depth, bound, best_move);
+        return best_score;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void Search::collectPv(const Position& root, int depth)
+    {
+        stats.pv.clear();
+        Position position = root;
+        MoveList moves;
+        for (int ply = 0; ply < depth; ply++) {
+            const TranspositionTable::Entry* entry = table.probe(tableKey(position));
+            if (entry == nullptr)
+                break;
+            Move move = ply == 0 ? root_move : entry->move;
+            position.generateMoves(moves);
+            if (std::find(moves.begin(), moves.end(), move) == moves.end())
+                break;
+            stats.pv.push_back(move);
+            position.make(move);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    SearchResult Search::run(const Position& root, const SearchLimits& limits)
+    {
+        this->limits = limits;
+        start = std::chrono::steady_clock::now();
+        stats = SearchStats{};
+        stopped = false;
+
+        SearchResult result;
+        Position position = root;
+        MoveList moves;
+        position.generateMoves(moves);
+        if (moves.empty())
+            return result;
+
+        result.move = moves[0];
+        result.found = true;
+        if (network != nullptr)
+            network->refresh(position, accumulators[0]);
+
+        int max_depth = std::min(limits.depth, SearchLimits::MaxDepth);
+        for (int depth = 1; depth <= max_depth && !stopped; depth++) {
+            int score = alphaBeta(position, depth, -WinScore * 2, WinScore * 2, 0);
+            if (stopped)
+                break;
+
+            result.move = root_move;
+            result.score = score;
+            result.depth = depth;
+
+            stats.depth = depth;
+            stats.score = score;
+            stats.microseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+            stats.milliseconds = stats.microseconds / 1000;
+            collectPv(root, depth);
+            if (on_iteration)
+                on_iteration(stats);
+
+            if (score >= WinScore || score <= -WinScore)
+                break;      // game result is proven
+        }
+        stats.microseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        stats.milliseconds = stats.microseconds / 1000;
+        return result;
+    }
+}
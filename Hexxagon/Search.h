@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Evaluation.h"
+#include "Network.h"
+#include "Position.h"
+
+namespace Hexxagon
+{
+
+    ////////////////////////////////////////////////////////////
+    /// Hash table of searched positions, shared between
+    /// iterations and searches of one Search object.
+    ////////////////////////////////////////////////////////////
+    class TranspositionTable
+    {
+    public:
+        enum Bound : std::uint8_t { None, Exact, Lower, Upper };
+
+        struct Entry
+        {
+            std::uint64_t key = 0;
+            std::int16_t score = 0;
+            std::int8_t depth = 0;
+            Bound bound = None;
+            Move move;
+        };
+
+    private:
+        std::vector<Entry> entries;
+        std::uint64_t mask;
+
+    public:
+        explicit TranspositionTable(std::size_t megabytes);
+
+        const Entry* probe(std::uint64_t key) const;      //!< returns entry of the position, or nullptr
+
+        void store(std::uint64_t key, int score, int depth, Bound bound, Move move);
+
+        void clear();
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Search constraints. Zero means no limit.
+    ////////////////////////////////////////////////////////////
+    struct SearchLimits
+    {
+        static constexpr int MaxDepth = 32;
+
+        int depth = MaxDepth;
+        std::uint64_t nodes = 0;
+        int milliseconds = 0;
+        const std::atomic<bool>* stop = nullptr;        //!< search ends soon after it turns 'true', e.g. from another thread
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Statistics of the last search. Counters are plain members
+    /// of the Search object, each thread searches with own one.
+    ////////////////////////////////////////////////////////////
+    struct SearchStats
+    {
+        std::uint64_t nodes = 0;
+        std::uint64_t milliseconds = 0;
+        std::uint64_t microseconds = 0;         //!< same time, precise enough for node rates of short searches
+        int depth = 0;              //!< last completed iteration
+        int score = 0;              //!< score of the last completed iteration
+        std::uint64_t table_probes = 0;
+        std::uint64_t table_hits = 0;
+        std::uint64_t cutoffs = 0;              //!< nodes, where a move failed high
+        std::uint64_t first_move_cutoffs = 0;   //!< cutoffs made by the first searched move
+        std::vector<Move> pv;       //!< principal variation of the last completed iteration
+
+        std::uint64_t getNodesPerSecond() const { return microseconds > 0 ? nodes * 1000000 / microseconds : 0; }
+
+        double getTableHitRate() const { return table_probes > 0 ? (double)table_hits / table_probes : 0; }
+
+        double getFirstMoveCutoffRate() const { return cutoffs > 0 ? (double)first_move_cutoffs / cutoffs : 0; }
+    };
+
+    struct SearchResult
+    {
+        Move move;
+        int score = 0;
+        int depth = 0;      //!< last completed iteration
+        bool found = false;     //!< 'false' if position has no moves
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Iterative deepening alpha-beta search.
+    ////////////////////////////////////////////////////////////
+    class Search
+    {
+    private:
+        TranspositionTable table;
+        EvalWeights weights;
+        const Network* network = nullptr;       //!< replaces evaluate() when set
+        int noise = 0;      //!< amplitude of evaluation error
+        std::uint64_t noise_key = 0;        //!< seeds the error and keeps noisy entries of the table apart, 0 without noise
+        std::vector<Accumulator> accumulators;  //!< network state per ply of the current line
+
+        SearchLimits limits;
+        std::chrono::steady_clock::time_point start;
+        SearchStats stats;
+        std::function<void(const SearchStats&)> on_iteration;
+        bool stopped = false;
+        Move root_move;     //!< best move of the current iteration
+
+        int alphaBeta(Position& position, int depth, int alpha, int beta, int ply);
+
+        /// Returns evaluation of the position with the error of
+        /// setNoise(), which depends on the position only, so
+        /// transpositions get the same score.
+        ///
+        int evaluateLeaf(const Position& position, int ply) const;
+
+        std::uint64_t tableKey(const Position& position) const { return position.getHash() ^ noise_key; }
+
+        /// Scores moves for ordering: hash move first, then
+        /// moves capturing more gamechips, clones before jumps.
+        ///
+        void scoreMoves(const Position& position, const MoveList& moves, Move hash_move, int* scores) const;
+
+        bool outOfLimits();
+
+        /// Follows hash moves from the root.
+        ///
+        void collectPv(const Position& root, int depth);
+
+    public:
+        explicit Search(std::size_t table_megabytes = 16);
+
+        SearchResult run(const Position& position, const SearchLimits& limits);
+
+        void setWeights(const EvalWeights& weights);
+
+        /// Evaluates positions with the network instead of the
+        /// weighted terms. nullptr turns it off. The network has
+        /// to outlive the searches.
+        ///
+        void setNetwork(const Network* network);
+
+        /// Adds error up to 'amplitude' to every evaluation, for
+        /// weak computer players. Same seed gives same errors.
+        /// 0 turns it off.
+        ///
+        void setNoise(int amplitude, std::uint64_t seed);
+
+        void clear();       //!< forgets all searched positions
+
+        /// Sets function called after every completed iteration.
+        ///
+        void setInfoCallback(std::function<void(const SearchStats&)> callback);
+
+        const SearchStats& getStats() const;       //!< returns statistics of the last run()
+    };
+}
@@ -0,0 +1,85 @@
+#include "Spectator.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include "GameBoard.h"
+
+namespace sf
+{
+	SpectatorGrid::SpectatorGrid(Hexxagon::MatchRunner& runner, const Font& font, Vector2f area) : runner(runner), topology(runner.getTopology()) {
+		const int count = runner.size();
+		const int columns = std::max(1, int(std::ceil(std::sqrt(float(count)))));
+		const int rows = (count + columns - 1) / columns;
+		const float cell = std::min(area.x / columns, area.y / rows);
+		const float field_radius = Hexxagon::Board::fitFieldRadius(topology, cell - LabelHeight - 4.f);
+
+		/////////////////////////////////////////////////////////
+		/// Hexagon fills of every cell of every board, in the
+		/// layout of Board::fieldLocation()
+		/////////////////////////////////////////////////////////
+		const float pi = 3.141592654f;
+		vertices.resize(std::size_t(count) * topology.cellCount() * VerticesPerCell);
+		for (int board = 0; board < count; board++) {
+			const Vector2f corner((board % columns) * cell, (board / columns) * cell);
+			for (int i = 0; i < topology.rows(); i++) {
+				for (int j = 0; j < topology.rowLength(i); j++) {
+					const int index = topology.index(i, j);
+					if (index < 0)
+						continue;
+					const Vector2f center = corner + Vector2f(0.f, LabelHeight) + Hexxagon::Board::fieldLocation(topology, field_radius, i, j) + Vector2f(field_radius, field_radius);
+					Vertex* v = &vertices[(std::size_t(board) * topology.cellCount() + index) * VerticesPerCell];
+					for (int k = 0; k < 6; k++) {
+						float angle = k * 2.f * pi / 6.f - pi / 2.f;
+						float next = angle + 2.f * pi / 6.f;
+						v[k * 3].position = center;
+						v[k * 3 + 1].position = center + Vector2f(std::cos(angle), std::sin(angle)) * field_radius;
+						v[k * 3 + 2].position = center + Vector2f(std::cos(next), std::sin(next)) * field_radius;
+					}
+				}
+			}
+
+			Text& label = labels.emplace_back(font, "", unsigned(LabelHeight - 4));
+			label.setPosition(corner);
+			recolor(board);
+		}
+	}
+
+	void SpectatorGrid::recolor(int board) {
+		const Hexxagon::MatchSnapshot& snapshot = runner.get(board);
+		for (int index = 0; index < topology.cellCount(); index++) {
+			const bool last = snapshot.ply > 0 && snapshot.last.to == index;
+			Color color = snapshot.pieces[Hexxagon::Position::Red].test(index) ? (last ? Color(255, 140, 140) : Color::Red) :
+				snapshot.pieces[Hexxagon::Position::Blue].test(index) ? (last ? Color(140, 140, 255) : Color::Blue) : Color::White;
+			if (snapshot.over)
+				color = Color(color.r * 3 / 5, color.g * 3 / 5, color.b * 3 / 5);
+
+			Vertex* v = &vertices[(std::size_t(board) * topology.cellCount() + index) * VerticesPerCell];
+			for (int k = 0; k < VerticesPerCell; k++)
+				v[k].color = color;
+		}
+
+		const int red = snapshot.pieces[Hexxagon::Position::Red].count();
+		const int blue = snapshot.pieces[Hexxagon::Position::Blue].count();
+		labels[board].setString("#" + std::to_string(snapshot.game) + "  ply " + std::to_string(snapshot.ply) + "  " +
+			std::to_string(red) + " : " + std::to_string(blue) + (snapshot.over ? (red > blue ? "  red wins" : blue > red ? "  blue wins" : "  draw") : ""));
+	}
+
+	bool SpectatorGrid::update() {
+		bool changed = false;
+		for (int board = 0; board < runner.size(); board++) {
+			if (runner.update(board)) {
+				recolor(board);
+				changed = true;
+			}
+		}
+		return changed;
+	}
+
+	void SpectatorGrid::draw(RenderTarget& target, const RenderStates& states) const {
+		RenderStates local = states;
+		local.transform *= getTransform();
+		target.draw(vertices, local);
+		for (const Text& label : labels)
+			target.draw(label, local);
+	}
+}
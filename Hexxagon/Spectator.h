@@ -0,0 +1,39 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "MatchRunner.h"
+
+namespace sf
+{
+	/// Grid of live engine games from MatchRunner. All boards
+	/// are one vertex array, which is built once: new positions
+	/// only recolor cells of boards, which have changed.
+	///
+	class SpectatorGrid : public Drawable, public Transformable {
+	public:
+		static constexpr int VerticesPerCell = 18;		//!< 6 triangles of hexagon fill
+		static constexpr float LabelHeight = 18.f;
+
+	private:
+		Hexxagon::MatchRunner& runner;
+		const Hexxagon::Topology& topology;
+
+		VertexArray vertices{ PrimitiveType::Triangles };
+		std::vector<Text> labels;		//!< game number and score per board
+
+		void recolor(int board);		//!< writes colors of board cells from its latest snapshot
+
+		void draw(RenderTarget& target, const RenderStates& states) const override;
+
+	public:
+		/// Lays boards out in a square-ish grid in the area.
+		///
+		SpectatorGrid(Hexxagon::MatchRunner& runner, const Font& font, Vector2f area);
+
+		/// Takes new positions from the runner. Returns 'true' if
+		/// any board has changed.
+		///
+		bool update();
+	};
+}
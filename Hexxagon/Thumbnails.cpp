@@ -0,0 +1,146 @@
+#include "Thumbnails.h"
+#include <algorithm>
+#include <cmath>
+#include "GameBoard.h"
+
+namespace sf
+{
+	ThumbnailRenderer::ThumbnailRenderer(const Hexxagon::Topology& topology, unsigned size, int capacity) : topology(topology), size(size), capacity(capacity) {
+		field_radius = Hexxagon::Board::fitFieldRadius(topology, float(size));
+		thread = std::thread(&ThumbnailRenderer::run, this);
+	}
+
+	ThumbnailRenderer::~ThumbnailRenderer() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_one();
+		thread.join();
+	}
+
+	const Texture* ThumbnailRenderer::get(const Hexxagon::Position& position) {
+		const std::uint64_t hash = position.getHash();
+		auto iter = lookup.find(hash);
+		if (iter != lookup.end()) {
+			slots.splice(slots.begin(), slots, iter->second);
+			return slots.front().texture.get();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!pending.insert(hash).second)
+				return nullptr;
+			requests.push_back(position);
+			if (requests.size() > capacity) {
+				pending.erase(requests.front().getHash());		// would be replaced in the cache anyway
+				requests.erase(requests.begin());
+			}
+		}
+		wake.notify_one();
+		return nullptr;
+	}
+
+	bool ThumbnailRenderer::update() {
+		std::vector<std::pair<std::uint64_t, Image>> ready;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			const int count = std::min<int>(finished.size(), UploadsPerFrame);
+			std::move(finished.begin(), finished.begin() + count, std::back_inserter(ready));
+			finished.erase(finished.begin(), finished.begin() + count);
+			for (const auto& [hash, image] : ready)
+				pending.erase(hash);
+		}
+
+		for (auto& [hash, image] : ready) {
+			if (lookup.contains(hash))
+				continue;
+			std::unique_ptr<Texture> texture;
+			if (slots.size() >= capacity) {
+				lookup.erase(slots.back().hash);
+				texture = std::move(slots.back().texture);
+				slots.pop_back();
+			}
+			else
+				texture = std::make_unique<Texture>();
+			texture->loadFromImage(image);
+			slots.push_front({ hash, std::move(texture) });
+			lookup[hash] = slots.begin();
+		}
+		return !ready.empty();
+	}
+
+	bool ThumbnailRenderer::isBusy() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return !pending.empty();
+	}
+
+	void ThumbnailRenderer::run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true) {
+			wake.wait(lock, [this] { return !requests.empty() || stopping; });
+			if (stopping)
+				return;
+
+			/////////////////////////////////////////////////////////
+			/// Newest requests first: they are the rows in view
+			/////////////////////////////////////////////////////////
+			std::vector<Hexxagon::Position> batch;
+			while (!requests.empty() && batch.size() < BatchSize) {
+				batch.push_back(requests.back());
+				requests.pop_back();
+			}
+
+			lock.unlock();
+			std::vector<std::pair<std::uint64_t, Image>> rendered;
+			for (const Hexxagon::Position& position : batch)
+				rendered.emplace_back(position.getHash(), render(position));
+			lock.lock();
+
+			std::move(rendered.begin(), rendered.end(), std::back_inserter(finished));
+		}
+	}
+
+	Image ThumbnailRenderer::render(const Hexxagon::Position& position) const {
+		Image image;
+		image.create({ size, size }, Color::Transparent);
+
+		/////////////////////////////////////////////////////////
+		/// Pointy top hexagon per cell, filled by testing pixel
+		/// centers: |x| <= r * sqrt(3) / 2 and |x| / sqrt(3) + |y| <= r
+		/////////////////////////////////////////////////////////
+		const float sqrt3 = 1.7320508075688772f;
+		const float half_width = field_radius * sqrt3 / 2.f;
+		const Vector2f board_size = Hexxagon::Board::fieldLocation(topology, field_radius, topology.rows() - 1, 0) + Vector2f(field_radius * 2, field_radius * 2);
+		const Vector2f offset((size - (topology.rows() * 2.f * field_radius)) / 2.f, (size - board_size.y) / 2.f);
+
+		for (int i = 0; i < topology.rows(); i++) {
+			for (int j = 0; j < topology.rowLength(i); j++) {
+				const int index = topology.index(i, j);
+				if (index < 0)
+					continue;
+				const Color color = position.getPieces(Hexxagon::Position::Red).test(index) ? Color::Red :
+					position.getPieces(Hexxagon::Position::Blue).test(index) ? Color::Blue : Color::White;
+				const Vector2f center = offset + Hexxagon::Board::fieldLocation(topology, field_radius, i, j) + Vector2f(field_radius, field_radius);
+
+				const int left = std::max(0, int(center.x - half_width));
+				const int right = std::min(int(size) - 1, int(center.x + half_width));
+				const int top = std::max(0, int(center.y - field_radius));
+				const int bottom = std::min(int(size) - 1, int(center.y + field_radius));
+				for (int y = top; y <= bottom; y++) {
+					for (int x = left; x <= right; x++) {
+						const float dx = std::abs(x + 0.5f - center.x);
+						const float dy = std::abs(y + 0.5f - center.y);
+						if (dx <= half_width && dx / sqrt3 + dy <= field_radius)
+							image.setPixel({ unsigned(x), unsigned(y) }, color);
+					}
+				}
+			}
+		}
+		return image;
+	}
+
+	unsigned ThumbnailRenderer::getSize() const {
+		return size;
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "Position.h"
+
+namespace sf
+{
+	/// Miniature game boards for save browsers and analysis views.
+	///
+	/// Positions are drawn into images on a background thread, so
+	/// no GL context is needed there, and uploaded to textures on
+	/// the render thread by update(). Textures are cached by Zobrist
+	/// hash and the least recently used one is replaced when the
+	/// cache is full. Cells follow the layout of Board::fieldLocation().
+	///
+	class ThumbnailRenderer {
+	public:
+		static constexpr int DefaultCapacity = 256;
+		static constexpr int BatchSize = 16;		//!< positions rendered per lock of the request queue
+		static constexpr int UploadsPerFrame = 8;		//!< keeps texture uploads from stalling a frame
+
+	private:
+		struct Slot {
+			std::uint64_t hash;
+			std::unique_ptr<Texture> texture;
+		};
+
+		const Hexxagon::Topology& topology;
+		unsigned size;		//!< width and height of thumbnail in pixels
+		float field_radius;
+		int capacity;
+
+		std::list<Slot> slots;		//!< cached textures, most recently used first
+		std::unordered_map<std::uint64_t, std::list<Slot>::iterator> lookup;
+
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::vector<Hexxagon::Position> requests;		//!< positions to render, newest last
+		std::unordered_set<std::uint64_t> pending;		//!< hashes requested, but not uploaded yet
+		std::vector<std::pair<std::uint64_t, Image>> finished;		//!< rendered images waiting for upload
+		bool stopping = false;
+		std::thread thread;
+
+		void run();
+
+	public:
+		ThumbnailRenderer(const Hexxagon::Topology& topology, unsigned size, int capacity = DefaultCapacity);
+
+		ThumbnailRenderer(const ThumbnailRenderer&) = delete;
+		ThumbnailRenderer& operator=(const ThumbnailRenderer&) = delete;
+
+		~ThumbnailRenderer();
+
+		/// Returns cached thumbnail of the position, or nullptr
+		/// and queues the position for rendering.
+		///
+		const Texture* get(const Hexxagon::Position& position);
+
+		/// Uploads rendered images to textures. Has to be called
+		/// on the render thread. Returns 'true' if any thumbnail
+		/// became available.
+		///
+		bool update();
+
+		bool isBusy();		//!< returns 'true' while requested thumbnails are not uploaded
+
+		/// Draws the position on CPU into image of thumbnail size.
+		///
+		Image render(const Hexxagon::Position& position) const;
+
+		unsigned getSize() const;
+	};
+}
@@ -0,0 +1,58 @@
+#include "Topology.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    std::optional<TopologyDescriptor> TopologyDescriptor::load(const std::string& path)
+    {
+        std::fstream stream(path, std::ios::in);
+        if (!stream.is_open()) {
+            std::cout << "Board file " << path << " could not be opened\n";
+            return std::nullopt;
+        }
+
+        TopologyDescriptor descriptor;
+        std::string line;
+        while (std::getline(stream, line)) {
+            std::istringstream str_line(line);
+            std::string key;
+            if (!(str_line >> key) || key.starts_with("#"))
+                continue;
+
+            Hex hex;
+            if (key == "radius" && str_line >> descriptor.radius)
+                continue;
+            if (str_line >> hex.q >> hex.r) {
+                if (key == "hole" && descriptor.holeCount < MaxHoles) {
+                    descriptor.holes[descriptor.holeCount++] = hex;
+                    continue;
+                }
+                if ((key == "red" || key == "blue") && descriptor.startCount < MaxPlacements) {
+                    descriptor.start[descriptor.startCount++] = { hex, key == "red" ? 0 : 1 };
+                    continue;
+                }
+            }
+            std::cout << "Wrong board file line: " << line << "\n";
+            return std::nullopt;
+        }
+
+        if (descriptor.radius < 1 || descriptor.radius > MaxRadius) {
+            std::cout << "Board radius has to be in range 1.." << MaxRadius << "\n";
+            return std::nullopt;
+        }
+        return descriptor;
+    }
+
+    ////////////////////////////////////////////////////////////
+    Topology::Topology(const TopologyDescriptor& descriptor) : tables(deriveTables(descriptor)) {}
+
+    ////////////////////////////////////////////////////////////
+    const Topology& Topology::standard()
+    {
+        static constinit const Topology topology(StandardTables);
+        return topology;
+    }
+}
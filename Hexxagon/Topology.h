@@ -0,0 +1,219 @@
+#pragma once
+
+#include <array>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include "Bitboard.h"
+
+namespace Hexxagon
+{
+
+    ////////////////////////////////////////////////////////////
+    /// Axial coordinates of a hexagonal cell. Central cell
+    /// of the game board is (0, 0), 'r' grows downwards.
+    ////////////////////////////////////////////////////////////
+    struct Hex
+    {
+        int q = 0;
+        int r = 0;
+
+        constexpr bool operator==(const Hex&) const = default;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Gamechip placed on the game board at the start.
+    ////////////////////////////////////////////////////////////
+    struct Placement
+    {
+        Hex hex;
+        int player = 0;     //!< 0 - red, 1 - blue
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Description of a game board: hexagon radius, cells
+    /// removed from it and initial gamechips placement.
+    ////////////////////////////////////////////////////////////
+    struct TopologyDescriptor
+    {
+        static constexpr int MaxRadius = 6;         //!< radius 6 hexagon has 127 cells, the most which fits into Bitboard
+        static constexpr int MaxHoles = 32;
+        static constexpr int MaxPlacements = 32;
+
+        int radius = 0;
+        std::array<Hex, MaxHoles> holes{};
+        int holeCount = 0;
+        std::array<Placement, MaxPlacements> start{};
+        int startCount = 0;
+
+        constexpr TopologyDescriptor() = default;
+
+        constexpr TopologyDescriptor(int radius, std::initializer_list<Hex> holes, std::initializer_list<Placement> start) : radius(radius)
+        {
+            for (const Hex& hex : holes)
+                this->holes[holeCount++] = hex;
+            for (const Placement& placement : start)
+                this->start[startCount++] = placement;
+        }
+
+        /// Reads descriptor from text file with lines
+        /// "radius <n>", "hole <q> <r>", "red <q> <r>" and "blue <q> <r>".
+        ///
+        static std::optional<TopologyDescriptor> load(const std::string& path);
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Tables derived from a TopologyDescriptor: cell indices,
+    /// neighbour masks and initial position.
+    ////////////////////////////////////////////////////////////
+    struct TopologyTables
+    {
+        static constexpr int MaxCells = Bitboard::Capacity;
+        static constexpr int MaxRows = 2 * TopologyDescriptor::MaxRadius + 1;
+
+        int radius = 0;
+        int cellCount = 0;
+
+        std::array<Hex, MaxCells> hexes{};               //!< axial coordinates of every cell
+        std::array<int, MaxRows * MaxRows> grid{};       //!< cell index of every (r, q) pair, -1 for holes and pairs out of hexagon
+
+        std::array<Bitboard, MaxCells> close{};          //!< cells at distance 1, reachable by cloning
+        std::array<Bitboard, MaxCells> distant{};        //!< cells at distance 2, reachable by jumping
+
+        Bitboard cells;
+        std::array<Bitboard, 2> start{};
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Derives topology tables. Cells are indexed row by row,
+    /// from left to right, the same order game board is drawn in.
+    ////////////////////////////////////////////////////////////
+    constexpr TopologyTables deriveTables(const TopologyDescriptor& descriptor)
+    {
+        constexpr int rows = TopologyTables::MaxRows;
+        TopologyTables t{};
+        t.radius = descriptor.radius;
+        t.grid.fill(-1);
+
+        int R = descriptor.radius;
+        for (int r = -R; r <= R; r++) {
+            for (int q = -R; q <= R; q++) {
+                if (q + r < -R || q + r > R)
+                    continue;
+
+                bool hole = false;
+                for (int i = 0; i < descriptor.holeCount; i++)
+                    hole = hole || descriptor.holes[i] == Hex{ q, r };
+                if (hole)
+                    continue;
+
+                t.grid[(r + R) * rows + (q + R)] = t.cellCount;
+                t.hexes[t.cellCount] = { q, r };
+                t.cells.set(t.cellCount);
+                t.cellCount++;
+            }
+        }
+
+        for (int i = 0; i < t.cellCount; i++) {
+            for (int j = 0; j < t.cellCount; j++) {
+                int dq = t.hexes[i].q - t.hexes[j].q;
+                int dr = t.hexes[i].r - t.hexes[j].r;
+                int distance = ((dq < 0 ? -dq : dq) + (dr < 0 ? -dr : dr) + (dq + dr < 0 ? -dq - dr : dq + dr)) / 2;
+                if (distance == 1)
+                    t.close[i].set(j);
+                else if (distance == 2)
+                    t.distant[i].set(j);
+            }
+        }
+
+        for (int i = 0; i < descriptor.startCount; i++) {
+            const Placement& placement = descriptor.start[i];
+            int q = placement.hex.q, r = placement.hex.r;
+            if (r >= -R && r <= R && q >= -R && q <= R && t.grid[(r + R) * rows + (q + R)] >= 0)
+                t.start[placement.player].set(t.grid[(r + R) * rows + (q + R)]);
+        }
+        return t;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Standard Hexxagon board: radius 4 hexagon with three
+    /// holes around the center and gamechips in the corners.
+    ////////////////////////////////////////////////////////////
+    inline constexpr TopologyDescriptor StandardDescriptor{
+        4,
+        { { 1, -1 }, { -1, 0 }, { 0, 1 } },
+        {
+            { { 4, -4 }, 0 }, { { -4, 0 }, 0 }, { { 0, 4 }, 0 },
+            { { 0, -4 }, 1 }, { { 4, 0 }, 1 }, { { -4, 4 }, 1 }
+        }
+    };
+
+    inline constexpr TopologyTables StandardTables = deriveTables(StandardDescriptor);      //!< computed at compile time
+
+    static_assert(StandardTables.cellCount == 58);
+
+    ////////////////////////////////////////////////////////////
+    /// Game board geometry, from which neighbour tables,
+    /// rendering layout and move generation are derived.
+    ////////////////////////////////////////////////////////////
+    class Topology
+    {
+    private:
+        TopologyTables tables;
+
+    public:
+        constexpr explicit Topology(const TopologyTables& tables) : tables(tables) {}
+
+        explicit Topology(const TopologyDescriptor& descriptor);
+
+        static const Topology& standard();      //!< returns standard board, whose tables were built at compile time
+
+        int radius() const { return tables.radius; }
+
+        int cellCount() const { return tables.cellCount; }
+
+        int rows() const { return 2 * tables.radius + 1; }
+
+        int rowLength(int row) const { return rows() - (row > tables.radius ? row - tables.radius : tables.radius - row); }
+
+        /// Returns index of the cell with provided axial
+        /// coordinates, or -1 for holes and cells out of board.
+        ///
+        int index(Hex hex) const
+        {
+            int R = tables.radius;
+            if (hex.q < -R || hex.q > R || hex.r < -R || hex.r > R)
+                return -1;
+            return tables.grid[(hex.r + R) * TopologyTables::MaxRows + (hex.q + R)];
+        }
+
+        /// Returns index of the cell in provided row and column
+        /// of the drawn board, or -1 for holes and slots out of board.
+        ///
+        int index(int row, int column) const
+        {
+            if (row < 0 || row >= rows() || column < 0 || column >= rowLength(row))
+                return -1;
+            int r = row - tables.radius;
+            return index(Hex{ column - tables.radius - (r < 0 ? r : 0), r });
+        }
+
+        Hex hex(int index) const { return tables.hexes[index]; }
+
+        int row(int index) const { return tables.hexes[index].r + tables.radius; }
+
+        int column(int index) const
+        {
+            Hex h = tables.hexes[index];
+            return h.q + tables.radius + (h.r < 0 ? h.r : 0);
+        }
+
+        const Bitboard& close(int index) const { return tables.close[index]; }
+
+        const Bitboard& distant(int index) const { return tables.distant[index]; }
+
+        const Bitboard& cells() const { return tables.cells; }
+
+        const Bitboard& start(int player) const { return tables.start[player]; }
+    };
+}
@@ -0,0 +1,111 @@
+#include "TrainingData.h"
+#include <cstdio>
+#include <cstring>
+
+namespace Hexxagon
+{
+    namespace
+    {
+        void writeLE(char* out, std::uint64_t value, int bytes)
+        {
+            for (int i = 0; i < bytes; i++)
+                out[i] = (char)((value >> (i * 8)) & 0xFF);
+        }
+
+        std::uint64_t readLE(const char* in, int bytes)
+        {
+            std::uint64_t value = 0;
+            for (int i = 0; i < bytes; i++)
+                value |= (std::uint64_t)(unsigned char)in[i] << (i * 8);
+            return value;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void TrainingRecord::write(char* out) const
+    {
+        for (int player : { Position::Red, Position::Blue }) {
+            writeLE(out + player * 16, pieces[player].lo, 8);
+            writeLE(out + player * 16 + 8, pieces[player].hi, 8);
+        }
+        writeLE(out + 32, (std::uint16_t)score, 2);
+        out[34] = (char)side;
+        out[35] = (char)result;
+    }
+
+    ////////////////////////////////////////////////////////////
+    TrainingRecord TrainingRecord::read(const char* in)
+    {
+        TrainingRecord record;
+        for (int player : { Position::Red, Position::Blue })
+            record.pieces[player] = { readLE(in + player * 16, 8), readLE(in + player * 16 + 8, 8) };
+        record.score = (std::int16_t)readLE(in + 32, 2);
+        record.side = (std::uint8_t)in[34];
+        record.result = (std::int8_t)in[35];
+        return record;
+    }
+
+    ////////////////////////////////////////////////////////////
+    Position TrainingRecord::toPosition(const Topology& topology) const
+    {
+        Position position(topology);
+        for (Bitboard cells = topology.cells(); cells; )
+            position.clear(cells.popFirst());
+        for (int player : { Position::Red, Position::Blue })
+            for (Bitboard own = pieces[player] & topology.cells(); own; )
+                position.place(own.popFirst(), player);
+        position.setSide(side);
+        return position;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool TrainingShard::checkHeader(const char* data, std::size_t size, const Topology& topology)
+    {
+        return size >= HeaderSize && std::memcmp(data, Magic, 4) == 0 &&
+            readLE(data + 4, 4) == Version && readLE(data + 8, 4) == (std::uint64_t)topology.cellCount();
+    }
+
+
+    /***********************************************************/
+    /// ShardWriter class methods initialisation.
+    /***********************************************************/
+    ShardWriter::ShardWriter(const std::string& path, const Topology& topology)
+    {
+        file = std::fopen(path.c_str(), "wb");
+        if (file == nullptr)
+            return;
+        char header[TrainingShard::HeaderSize] = {};
+        std::memcpy(header, TrainingShard::Magic, 4);
+        writeLE(header + 4, TrainingShard::Version, 4);
+        writeLE(header + 8, topology.cellCount(), 4);
+        std::fwrite(header, 1, sizeof(header), file);
+        buffer.reserve(BufferSize);
+    }
+
+    ////////////////////////////////////////////////////////////
+    ShardWriter::~ShardWriter()
+    {
+        if (file != nullptr) {
+            flush();
+            std::fclose(file);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ShardWriter::add(const TrainingRecord& record)
+    {
+        if (buffer.size() + TrainingRecord::Size > BufferSize)
+            flush();
+        buffer.resize(buffer.size() + TrainingRecord::Size);
+        record.write(buffer.data() + buffer.size() - TrainingRecord::Size);
+        written++;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void ShardWriter::flush()
+    {
+        if (file != nullptr && !buffer.empty())
+            std::fwrite(buffer.data(), 1, buffer.size(), file);
+        buffer.clear();
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Position.h"
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    /// Labelled position of a self-play game.
+    ///
+    /// Shard file layout: "HXTD" magic, 32-bit version, 32-bit
+    /// cell count of the topology, 32-bit reserved word, then
+    /// records of 36 bytes each (red and blue bitboards as two
+    /// 64-bit words, 16-bit search score, side to move, final
+    /// result), little-endian.
+    ////////////////////////////////////////////////////////////
+    struct TrainingRecord
+    {
+        static constexpr std::size_t Size = 36;
+
+        Bitboard pieces[2];
+        std::int16_t score = 0;     //!< search score for the side to move
+        std::uint8_t side = Position::Red;
+        std::int8_t result = 0;     //!< game result for the side to move: 1 won, 0 draw, -1 lost
+
+        void write(char* out) const;
+
+        static TrainingRecord read(const char* in);
+
+        Position toPosition(const Topology& topology = Topology::standard()) const;
+    };
+
+    namespace TrainingShard
+    {
+        constexpr char Magic[4] = { 'H', 'X', 'T', 'D' };
+        constexpr std::uint32_t Version = 1;
+        constexpr std::size_t HeaderSize = 16;
+
+        /// Checks header of the shard. Returns 'false' if it
+        /// is not a shard or was written for other topology.
+        ///
+        bool checkHeader(const char* data, std::size_t size, const Topology& topology = Topology::standard());
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Appends records to a shard file, written by blocks.
+    ////////////////////////////////////////////////////////////
+    class ShardWriter
+    {
+    private:
+        std::FILE* file = nullptr;
+        std::vector<char> buffer;
+        std::uint64_t written = 0;
+
+        static constexpr std::size_t BufferSize = 1 << 20;
+
+    public:
+        ShardWriter(const std::string& path, const Topology& topology = Topology::standard());
+
+        ShardWriter(const ShardWriter&) = delete;
+        ShardWriter& operator=(const ShardWriter&) = delete;
+
+        ~ShardWriter();
+
+        bool isOpen() const { return file != nullptr; }
+
+        void add(const TrainingRecord& record);
+
+        void flush();
+
+        std::uint64_t getWritten() const { return written; }      //!< returns count of added records
+    };
+}
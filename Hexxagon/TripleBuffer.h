@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Hexxagon
+{
+    ////////////////////////////////////////////////////////////
+    /// Lock-free handoff of the latest value from one writer
+    /// thread to one reader thread. Writer fills its buffer and
+    /// publishes it, reader takes the newest published one;
+    /// neither ever waits and values in between may be skipped.
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    class TripleBuffer
+    {
+    private:
+        static constexpr std::uint8_t IndexMask = 0b011;
+        static constexpr std::uint8_t FreshBit = 0b100;     //!< set when middle buffer wasn't taken by reader yet
+
+        struct alignas(64) Slot     //!< own cache line per buffer, so writer and reader don't share lines
+        {
+            T value{};
+        };
+
+        std::array<Slot, 3> slots;
+        alignas(64) std::atomic<std::uint8_t> middle{ 1 };      //!< index of the buffer between writer and reader
+        alignas(64) std::uint8_t back = 0;      //!< index of writer's buffer
+        alignas(64) std::uint8_t front = 2;     //!< index of reader's buffer
+
+    public:
+        /// Writer side.
+        ///
+        T& writeBuffer() { return slots[back].value; }
+
+        void publish()      //!< hands written buffer to reader and takes the stale one
+        {
+            back = middle.exchange(back | FreshBit, std::memory_order_acq_rel) & IndexMask;
+        }
+
+        /// Reader side.
+        ///
+        bool update()       //!< takes newest published buffer, returns 'false' if nothing new
+        {
+            if (!(middle.load(std::memory_order_relaxed) & FreshBit))
+                return false;
+            front = middle.exchange(front, std::memory_order_acq_rel) & IndexMask;
+            return true;
+        }
+
+        const T& read() const { return slots[front].value; }
+    };
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "Bitboard.h"
+
+namespace Hexxagon
+{
+
+    ////////////////////////////////////////////////////////////
+    /// Random keys for Zobrist hashing of positions: one key
+    /// per cell per player, and one for blue to move. Keys
+    /// are generated at compile time, so hashes are stable
+    /// between runs and can be stored in files.
+    ////////////////////////////////////////////////////////////
+    struct ZobristKeys
+    {
+        std::array<std::array<std::uint64_t, Bitboard::Capacity>, 2> cells{};
+        std::uint64_t side = 0;
+    };
+
+    constexpr std::uint64_t splitmix64(std::uint64_t& state)
+    {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    constexpr ZobristKeys generateZobristKeys()
+    {
+        ZobristKeys keys{};
+        std::uint64_t state = 0x48455858414741ull;      // "HEXXAGA"
+        for (auto& player : keys.cells)
+            for (std::uint64_t& key : player)
+                key = splitmix64(state);
+        keys.side = splitmix64(state);
+        return keys;
+    }
+
+    inline constexpr ZobristKeys Zobrist = generateZobristKeys();
+}
@@ -0,0 +1,253 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <vector>
+#include "GameBoard.h"
+#include "Network.h"
+#include "ScoreRec.h"
+#include "Zobrist.h"
+
+using namespace Hexxagon;
+
+/// Microbenchmarks of the engine and of the game board code.
+/// All of them cycle through the same seeded set of positions,
+/// so results are comparable between commits in ns per operation.
+///
+
+/// Game played with random moves from the start position.
+///
+struct Sample {
+	std::vector<Move> moves;
+	Position position;
+};
+
+static const std::vector<Sample>& samples() {
+	static const std::vector<Sample> set = [] {
+		constexpr int Count = 64;
+		std::mt19937 random(20240101);
+		std::vector<Sample> set;
+		MoveList moves;
+		while (set.size() < Count) {
+			Sample sample;
+			int plies = 5 + random() % 56;
+			for (int ply = 0; ply < plies && !sample.position.isGameOver(); ply++) {
+				sample.position.generateMoves(moves);
+				Move move = moves[random() % moves.size()];
+				sample.moves.push_back(move);
+				sample.position.make(move);
+			}
+			if (!sample.position.isGameOver())
+				set.push_back(sample);
+		}
+		return set;
+	}();
+	return set;
+}
+
+/// Game boards with the sample games played on them: the
+/// pointer based code, which the engine is compared against.
+///
+static const std::vector<std::unique_ptr<Board>>& boards() {
+	static const std::vector<std::unique_ptr<Board>> set = [] {
+		std::vector<std::unique_ptr<Board>> set;
+		for (const Sample& sample : samples()) {
+			set.push_back(std::make_unique<Board>(35.f, false));
+			for (Move move : sample.moves)
+				set.back()->play(move);
+		}
+		return set;
+	}();
+	return set;
+}
+
+/// Temporary working directory with an empty saves folder,
+/// so file benchmarks don't touch the player's saves and
+/// save index. Back in the old directory on destruction.
+///
+struct ScratchDirectory {
+	std::filesystem::path previous = std::filesystem::current_path();
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "hexxagon_bench";
+
+	ScratchDirectory() {
+		std::filesystem::create_directories(path / SaveIndex::Directory);
+		std::filesystem::current_path(path);
+	}
+
+	~ScratchDirectory() {
+		std::filesystem::current_path(previous);
+		std::error_code error;
+		std::filesystem::remove_all(path, error);
+	}
+};
+
+
+/***********************************************************/
+/// Engine
+/***********************************************************/
+static void BM_GenerateMoves(benchmark::State& state) {
+	const auto& set = samples();
+	MoveList moves;
+	std::size_t i = 0;
+	for (auto _ : state) {
+		set[i++ % set.size()].position.generateMoves(moves);
+		benchmark::DoNotOptimize(moves.size());
+	}
+}
+BENCHMARK(BM_GenerateMoves);
+
+static void BM_MakeUnmake(benchmark::State& state) {
+	std::vector<Position> positions;
+	std::vector<Move> first_moves;
+	MoveList moves;
+	for (const Sample& sample : samples()) {
+		positions.push_back(sample.position);
+		sample.position.generateMoves(moves);
+		first_moves.push_back(moves[moves.size() / 2]);
+	}
+	std::size_t i = 0;
+	for (auto _ : state) {
+		std::size_t index = i++ % positions.size();
+		Position::Undo undo = positions[index].make(first_moves[index]);
+		positions[index].unmake(undo);
+		benchmark::DoNotOptimize(positions[index]);
+	}
+}
+BENCHMARK(BM_MakeUnmake);
+
+static void BM_Evaluate(benchmark::State& state) {
+	const auto& set = samples();
+	const EvalWeights weights;
+	std::size_t i = 0;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(evaluate(set[i++ % set.size()].position, weights));
+}
+BENCHMARK(BM_Evaluate);
+
+static void BM_NetworkRefresh(benchmark::State& state) {
+	const auto& set = samples();
+	static const Network network;
+	Accumulator accumulator;
+	std::size_t i = 0;
+	for (auto _ : state) {
+		const Position& position = set[i++ % set.size()].position;
+		network.refresh(position, accumulator);
+		benchmark::DoNotOptimize(network.evaluate(accumulator, position.getSide()));
+	}
+}
+BENCHMARK(BM_NetworkRefresh);
+
+static void BM_NetworkUpdate(benchmark::State& state) {
+	static const Network network;
+	std::vector<Position> positions;
+	std::vector<Move> first_moves;
+	std::vector<Accumulator> accumulators(samples().size());
+	MoveList moves;
+	for (const Sample& sample : samples()) {
+		positions.push_back(sample.position);
+		network.refresh(sample.position, accumulators[positions.size() - 1]);
+		sample.position.generateMoves(moves);
+		first_moves.push_back(moves[moves.size() / 2]);
+	}
+	Accumulator after;
+	std::size_t i = 0;
+	for (auto _ : state) {
+		std::size_t index = i++ % positions.size();
+		Position::Undo undo = positions[index].make(first_moves[index]);
+		network.update(accumulators[index], after, positions[index], undo);
+		benchmark::DoNotOptimize(network.evaluate(after, positions[index].getSide()));
+		positions[index].unmake(undo);
+	}
+}
+BENCHMARK(BM_NetworkUpdate);
+
+static void BM_HashFromScratch(benchmark::State& state) {
+	const auto& set = samples();
+	std::size_t i = 0;
+	for (auto _ : state) {
+		const Position& position = set[i++ % set.size()].position;
+		std::uint64_t hash = position.getSide() == Position::Blue ? Zobrist.side : 0;
+		for (int player : { Position::Red, Position::Blue })
+			for (Bitboard pieces = position.getPieces(player); pieces; )
+				hash ^= Zobrist.cells[player][pieces.popFirst()];
+		benchmark::DoNotOptimize(hash);
+	}
+}
+BENCHMARK(BM_HashFromScratch);
+
+static void BM_IsGameOver(benchmark::State& state) {
+	const auto& set = samples();
+	std::size_t i = 0;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(set[i++ % set.size()].position.isGameOver());
+}
+BENCHMARK(BM_IsGameOver);
+
+
+/***********************************************************/
+/// Game board
+/***********************************************************/
+static void BM_BoardCalculateProgress(benchmark::State& state) {
+	const auto& set = boards();
+	std::size_t i = 0;
+	for (auto _ : state)
+		set[i++ % set.size()]->getGameProgress()->calculateProgress();
+}
+BENCHMARK(BM_BoardCalculateProgress);
+
+static void BM_BoardToPosition(benchmark::State& state) {
+	const auto& set = boards();
+	std::size_t i = 0;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(set[i++ % set.size()]->toPosition());
+}
+BENCHMARK(BM_BoardToPosition);
+
+static void BM_BoardSerialize(benchmark::State& state) {
+	const auto& set = boards();
+	std::size_t i = 0;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(set[i++ % set.size()]->serialize());
+}
+BENCHMARK(BM_BoardSerialize);
+
+/// Synchronous write, which IoWorker does for every save.
+///
+static void BM_SaveWrite(benchmark::State& state) {
+	const std::string contents = boards()[0]->serialize();
+	ScratchDirectory scratch;
+	for (auto _ : state)
+		benchmark::DoNotOptimize(IoWorker::writeAtomically("Saves\\bench.bin", contents));
+	state.SetBytesProcessed(state.iterations() * contents.size());
+}
+BENCHMARK(BM_SaveWrite);
+
+static void BM_BoardLoad(benchmark::State& state) {
+	const std::string contents = boards()[0]->serialize();
+	ScratchDirectory scratch;
+	IoWorker::writeAtomically("Saves\\bench.bin", contents);
+	for (auto _ : state) {
+		Board board(35.f, std::string("bench"));
+		benchmark::DoNotOptimize(board.getGameProgress());
+	}
+}
+BENCHMARK(BM_BoardLoad);
+
+static void BM_ScoreSort(benchmark::State& state) {
+	static const sf::Font font;
+	std::mt19937 random(7);
+	std::vector<ScoreRec> scores;
+	for (int i = 0; i < state.range(0); i++)
+		scores.emplace_back("Red_" + std::to_string(random() % 1000) + ";" + std::to_string(random() % 58) + "|00:10:00", font);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		std::vector<ScoreRec> unsorted = scores;
+		state.ResumeTiming();
+		ScoreRec::sort(unsorted);
+		benchmark::DoNotOptimize(unsorted.data());
+	}
+}
+BENCHMARK(BM_ScoreSort)->Arg(5)->Arg(100);
+
+BENCHMARK_MAIN();
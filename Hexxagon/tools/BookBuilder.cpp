@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "OpeningBook.h"
+#include "Search.h"
+
+using namespace Hexxagon;
+
+/// Builds opening book from engine self-play games
+/// and/or archived games. With --archive only archived
+/// games are used, unless --games is given as well.
+///
+/// Archive file has one game per line: moves as
+/// "<from>:<to>" cell indices and result "red", "blue" or "draw".
+///
+struct Options {
+	int games = 1000;
+	int plies = 12;			// book depth in plies
+	int depth = 5;			// search depth of self-play moves
+	int random_plies = 2;		// random moves at the start, so games differ
+	int max_plies = 300;		// jumps alone can repeat forever, longer games are adjudicated
+	int threads = std::max(1u, std::thread::hardware_concurrency());
+	std::string archive;
+	std::string out = "Assets\\book.bin";
+};
+
+struct Record {
+	std::uint64_t key;
+	Move move;
+	int player;
+};
+
+/// Adds recorded moves to the book: 2 for moves of the
+/// winner, 1 for draws, nothing for the loser's moves.
+/// 'winner' is -1 for a draw.
+///
+static void addGame(std::vector<OpeningBook::Entry>& out, const std::vector<Record>& records, int winner) {
+	for (const Record& record : records) {
+		int weight = winner == -1 ? 1 : (record.player == winner ? 2 : 0);
+		if (weight > 0)
+			out.push_back({ record.key, record.move, (std::uint16_t)weight });
+	}
+}
+
+static void selfPlay(const Options& options, std::atomic<int>& next_game, std::vector<OpeningBook::Entry>& out) {
+	Search search(8);
+	MoveList moves;
+	for (int game = next_game++; game < options.games; game = next_game++) {
+		std::mt19937 random(game);
+		Position position;
+		std::vector<Record> records;
+
+		for (int ply = 0; ply < options.max_plies && !position.isGameOver(); ply++) {
+			Move move;
+			if (ply < options.random_plies) {
+				position.generateMoves(moves);
+				move = moves[random() % moves.size()];
+			}
+			else {
+				SearchLimits limits;
+				limits.depth = ply < options.plies ? options.depth : std::max(1, options.depth - 2);
+				move = search.run(position, limits).move;
+				if (ply < options.plies)
+					records.push_back({ position.getHash(), move, position.getSide() });
+			}
+			position.make(move);
+		}
+		int margin = position.count(Position::Red) - position.count(Position::Blue);
+		addGame(out, records, margin > 0 ? Position::Red : margin < 0 ? Position::Blue : -1);
+	}
+}
+
+/// Parses cell index of an archived move, 'false' if it's
+/// not a number or doesn't fit a cell.
+///
+static bool parseCell(const std::string& text, std::uint8_t& cell) {
+	std::size_t length = 0;
+	int index;
+	try {
+		index = std::stoi(text, &length);
+	}
+	catch (const std::logic_error&) {
+		return false;
+	}
+	if (length != text.size() || index < 0 || index > 255)
+		return false;
+	cell = (std::uint8_t)index;
+	return true;
+}
+
+static bool readArchive(const Options& options, std::vector<OpeningBook::Entry>& out) {
+	std::fstream stream(options.archive, std::ios::in);
+	if (!stream.is_open()) {
+		std::cout << "Archive " << options.archive << " could not be opened\n";
+		return false;
+	}
+
+	std::string line;
+	int games = 0;
+	while (std::getline(stream, line)) {
+		std::istringstream str_line(line);
+		std::string token;
+		Position position;
+		std::vector<Record> records;
+		MoveList legal;
+		bool valid = true;
+		bool finished = false;
+		int winner = -1;
+
+		while (str_line >> token && valid) {
+			if (token == "red" || token == "blue" || token == "draw") {
+				winner = token == "red" ? Position::Red : token == "blue" ? Position::Blue : -1;
+				finished = true;
+				break;
+			}
+			std::size_t colon = token.find(':');
+			Move move;
+			if (colon == std::string::npos || !parseCell(token.substr(0, colon), move.from) || !parseCell(token.substr(colon + 1), move.to)) {
+				valid = false;
+				break;
+			}
+			position.generateMoves(legal);
+			valid = std::find(legal.begin(), legal.end(), move) != legal.end();
+			if (valid && (int)records.size() < options.plies)
+				records.push_back({ position.getHash(), move, position.getSide() });
+			if (valid)
+				position.make(move);
+		}
+		if (!valid) {
+			std::cout << "Skipping game with illegal move: " << line << "\n";
+			continue;
+		}
+		if (!finished) {
+			std::cout << "Skipping game without result: " << line << "\n";
+			continue;
+		}
+		addGame(out, records, winner);
+		games++;
+	}
+	std::cout << "Read " << games << " archived games\n";
+	return true;
+}
+
+int main(int argc, char* argv[]) {
+	Options options;
+	bool games_given = false;
+	for (int i = 1; i < argc; i += 2) {
+		std::string arg = argv[i];
+		if (i + 1 == argc) {
+			std::cout << "Option " << arg << " has no value\n";
+			return 1;
+		}
+		else if (arg == "--games") {
+			options.games = std::stoi(argv[i + 1]);
+			games_given = true;
+		}
+		else if (arg == "--plies") options.plies = std::stoi(argv[i + 1]);
+		else if (arg == "--depth") options.depth = std::stoi(argv[i + 1]);
+		else if (arg == "--random-plies") options.random_plies = std::stoi(argv[i + 1]);
+		else if (arg == "--max-plies") options.max_plies = std::stoi(argv[i + 1]);
+		else if (arg == "--threads") options.threads = std::stoi(argv[i + 1]);
+		else if (arg == "--archive") options.archive = argv[i + 1];
+		else if (arg == "--out") options.out = argv[i + 1];
+		else {
+			std::cout << "Unknown option " << arg << "\n";
+			return 1;
+		}
+	}
+	if (!options.archive.empty() && !games_given)
+		options.games = 0;
+
+	std::vector<std::vector<OpeningBook::Entry>> results(options.threads);
+	if (!options.archive.empty() && !readArchive(options, results[0]))
+		return 1;
+
+	std::atomic<int> next_game = 0;
+	std::vector<std::thread> threads;
+	for (int i = 0; i < options.threads; i++)
+		threads.emplace_back(selfPlay, std::cref(options), std::ref(next_game), std::ref(results[i]));
+	for (std::thread& thread : threads)
+		thread.join();
+
+	OpeningBook book;
+	for (const auto& entries : results)
+		for (const OpeningBook::Entry& entry : entries)
+			book.add(entry.key, entry.move, entry.weight);
+	book.finalize();
+
+	if (!book.save(options.out)) {
+		std::cout << "Book could not be written to " << options.out << "\n";
+		return 1;
+	}
+	std::cout << "Written " << book.size() << " book entries to " << options.out << "\n";
+	return 0;
+}
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "Search.h"
+#include "TrainingData.h"
+
+using namespace Hexxagon;
+
+/// Plays engine-vs-engine games and writes labelled positions
+/// to shards "<out>-<thread>.bin", one per thread.
+///
+struct Options {
+	int games = 1000;
+	std::uint64_t nodes = 20000;	// search nodes per step
+	int random_plies = 4;		// random moves at the start, so games differ
+	int max_plies = 300;		// jumps alone can repeat forever, longer games are adjudicated
+	int threads = std::max(1u, std::thread::hardware_concurrency());
+	std::string out = "data";
+};
+
+/// Set of written position keys, split into stripes with
+/// own locks, so threads rarely wait for each other.
+///
+class SeenPositions {
+private:
+	static constexpr int Stripes = 64;
+
+	std::array<std::unordered_set<std::uint64_t>, Stripes> sets;
+	std::array<std::mutex, Stripes> locks;
+
+public:
+	bool insert(std::uint64_t key) {		// returns 'false' if key was already there
+		int stripe = key % Stripes;
+		std::lock_guard lock(locks[stripe]);
+		return sets[stripe].insert(key).second;
+	}
+};
+
+struct Progress {
+	std::atomic<std::uint64_t> positions = 0;
+	std::atomic<std::uint64_t> duplicates = 0;
+};
+
+static void selfPlay(const Options& options, int thread, std::atomic<int>& next_game, SeenPositions& seen, Progress& progress) {
+	ShardWriter writer(options.out + "-" + std::to_string(thread) + ".bin");
+	if (!writer.isOpen()) {
+		std::cout << "Shard of thread " << thread << " could not be created\n";
+		return;
+	}
+
+	Search search(8);
+	MoveList moves;
+	std::vector<TrainingRecord> records;
+	for (int game = next_game++; game < options.games; game = next_game++) {
+		std::mt19937 random(game);
+		Position position;
+		records.clear();
+
+		for (int ply = 0; ply < options.max_plies && !position.isGameOver(); ply++) {
+			Move move;
+			if (ply < options.random_plies) {
+				position.generateMoves(moves);
+				move = moves[random() % moves.size()];
+			}
+			else {
+				SearchLimits limits;
+				limits.nodes = options.nodes;
+				SearchResult result = search.run(position, limits);
+				move = result.move;
+
+				// proven results teach nothing about the evaluation
+				if (std::abs(result.score) < WinScore) {
+					if (seen.insert(position.getHash())) {
+						TrainingRecord record;
+						record.pieces[Position::Red] = position.getPieces(Position::Red);
+						record.pieces[Position::Blue] = position.getPieces(Position::Blue);
+						record.score = (std::int16_t)result.score;
+						record.side = (std::uint8_t)position.getSide();
+						records.push_back(record);
+					}
+					else
+						progress.duplicates++;
+				}
+			}
+			position.make(move);
+		}
+
+		int margin = position.count(Position::Red) - position.count(Position::Blue);
+		int red_result = margin > 0 ? 1 : margin < 0 ? -1 : 0;
+		for (TrainingRecord& record : records) {
+			record.result = (std::int8_t)(record.side == Position::Red ? red_result : -red_result);
+			writer.add(record);
+		}
+		progress.positions += records.size();
+	}
+}
+
+int main(int argc, char* argv[]) {
+	Options options;
+	for (int i = 1; i < argc; i += 2) {
+		std::string arg = argv[i];
+		if (i + 1 == argc) {
+			std::cout << "Option " << arg << " has no value\n";
+			return 1;
+		}
+		else if (arg == "--games") options.games = std::stoi(argv[i + 1]);
+		else if (arg == "--nodes") options.nodes = std::stoull(argv[i + 1]);
+		else if (arg == "--random-plies") options.random_plies = std::stoi(argv[i + 1]);
+		else if (arg == "--max-plies") options.max_plies = std::stoi(argv[i + 1]);
+		else if (arg == "--threads") options.threads = std::stoi(argv[i + 1]);
+		else if (arg == "--out") options.out = argv[i + 1];
+		else {
+			std::cout << "Unknown option " << arg << "\n";
+			return 1;
+		}
+	}
+
+	SeenPositions seen;
+	Progress progress;
+	std::atomic<int> next_game = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < options.threads; i++)
+		threads.emplace_back(selfPlay, std::cref(options), i, std::ref(next_game), std::ref(seen), std::ref(progress));
+	for (std::thread& thread : threads)
+		thread.join();
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	double per_second = progress.positions / std::max(seconds, 1e-9);
+	std::cout << "Written " << progress.positions << " positions (" << progress.duplicates << " duplicates skipped) in "
+		<< seconds << " s: " << per_second << " positions/s, " << per_second / options.threads << " per thread\n";
+	return 0;
+}
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Analysis.h"
+#include "Search.h"
+
+using namespace Hexxagon;
+
+/// Text protocol over standard input and output, for driving
+/// the engine from scripts and other programs.
+///
+///   position start [moves <from>:<to> ...]   sets position, clones are "<to>:<to>"
+///   go [depth N] [nodes N] [movetime MS]     searches, prints "info" lines and "bestmove";
+///                                            without limits searches for DefaultMoveTime
+///   analyze [movetime MS] [threads N]        judges every move of the position command,
+///                                            prints "step" lines and "summary"
+///   newgame                                  forgets searched positions
+///   quit
+///
+static constexpr int DefaultMoveTime = 1000;		// ms of 'go' without limits, full depth could take hours
+
+static std::string toString(Move move) {
+	return std::to_string(move.from) + ":" + std::to_string(move.to);
+}
+
+static bool parseMove(const Position& position, const std::string& token, Move& move) {
+	std::size_t colon = token.find(':');
+	if (colon == std::string::npos)
+		return false;
+	try {
+		move = { (std::uint8_t)std::stoi(token.substr(0, colon)), (std::uint8_t)std::stoi(token.substr(colon + 1)) };
+	}
+	catch (const std::exception&) {
+		return false;
+	}
+	MoveList legal;
+	position.generateMoves(legal);
+	return std::find(legal.begin(), legal.end(), move) != legal.end();
+}
+
+static void printInfo(const SearchStats& stats) {
+	std::cout << "info depth " << stats.depth
+		<< " score " << stats.score << " nodes " << stats.nodes << " nps " << stats.getNodesPerSecond()
+		<< " time " << stats.milliseconds << std::fixed << std::setprecision(1)
+		<< " tthits " << stats.getTableHitRate() * 100 << " firstcut " << stats.getFirstMoveCutoffRate() * 100 << " pv";
+	for (Move move : stats.pv)
+		std::cout << " " << toString(move);
+	std::cout << std::endl;
+}
+
+int main() {
+	Search search;
+	Position position;
+	std::vector<Move> moves;		// moves of the last position command, for analyze
+	std::string line;
+	search.setInfoCallback(printInfo);
+
+	while (std::getline(std::cin, line)) {
+		std::istringstream str_line(line);
+		std::string command;
+		str_line >> command;
+
+		if (command == "quit")
+			break;
+		else if (command == "newgame")
+			search.clear();
+		else if (command == "position") {
+			std::string token;
+			position = Position();
+			moves.clear();
+			str_line >> token;
+			if (token != "start") {
+				std::cout << "error unknown position " << token << std::endl;
+				continue;
+			}
+			if (str_line >> token && token == "moves") {
+				while (str_line >> token) {
+					Move move;
+					if (!parseMove(position, token, move)) {
+						std::cout << "error illegal move " << token << std::endl;
+						break;
+					}
+					position.make(move);
+					moves.push_back(move);
+				}
+			}
+		}
+		else if (command == "go") {
+			SearchLimits limits;
+			std::string name;
+			std::uint64_t value;
+			bool limited = false;
+			while (str_line >> name >> value) {
+				if (name == "depth") limits.depth = (int)value;
+				else if (name == "nodes") limits.nodes = value;
+				else if (name == "movetime") limits.milliseconds = (int)value;
+				else continue;
+				limited = true;
+			}
+			if (!limited)
+				limits.milliseconds = DefaultMoveTime;
+			SearchResult result = search.run(position, limits);
+			std::cout << "bestmove " << (result.found ? toString(result.move) : "none") << std::endl;
+		}
+		else if (command == "analyze") {
+			int milliseconds = 500, threads = 0;
+			std::string name;
+			int value;
+			while (str_line >> name >> value) {
+				if (name == "movetime") milliseconds = value;
+				else if (name == "threads") threads = value;
+			}
+			static constexpr const char* MarkNames[] = { "good", "inaccuracy", "mistake", "blunder" };
+			GameAnalysis analysis(Position(), moves, milliseconds, threads);
+			int marks[4] = {};
+			for (int step = 0; step < analysis.size(); step++) {
+				while (!analysis.isReady(step))
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				AnalyzedStep analyzed = analysis.get(step);
+				marks[analyzed.mark]++;
+				std::cout << "step " << step + 1 << " played " << toString(analyzed.played) << " score " << analyzed.played_score
+					<< " best " << toString(analyzed.best) << " score " << analyzed.best_score << " loss " << analyzed.getLoss()
+					<< " " << MarkNames[analyzed.mark] << std::endl;
+			}
+			std::cout << "summary inaccuracies " << marks[AnalyzedStep::Inaccuracy] << " mistakes " << marks[AnalyzedStep::Mistake]
+				<< " blunders " << marks[AnalyzedStep::Blunder] << std::endl;
+		}
+		else if (!command.empty())
+			std::cout << "error unknown command " << command << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// Read-only file mapped into memory, so large data files
+/// are paged in by the system instead of being copied.
+///
+class MappedFile {
+private:
+	const char* data = nullptr;
+	std::size_t size = 0;
+#ifdef _WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+#endif
+
+public:
+	explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		LARGE_INTEGER file_size;
+		if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+			return;
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr)
+			return;
+		data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		size = data != nullptr ? (std::size_t)file_size.QuadPart : 0;
+#else
+		int fd = open(path.c_str(), O_RDONLY);
+		struct stat info;
+		if (fd < 0)
+			return;
+		if (fstat(fd, &info) == 0 && info.st_size > 0) {
+			void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (view != MAP_FAILED) {
+				data = (const char*)view;
+				size = info.st_size;
+				madvise(view, size, MADV_SEQUENTIAL);
+			}
+		}
+		close(fd);
+#endif
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	~MappedFile() {
+#ifdef _WIN32
+		if (data != nullptr)
+			UnmapViewOfFile(data);
+		if (mapping != nullptr)
+			CloseHandle(mapping);
+		if (file != INVALID_HANDLE_VALUE)
+			CloseHandle(file);
+#else
+		if (data != nullptr)
+			munmap((void*)data, size);
+#endif
+	}
+
+	bool isOpen() const { return data != nullptr; }
+
+	const char* getData() const { return data; }
+
+	std::size_t getSize() const { return size; }
+};
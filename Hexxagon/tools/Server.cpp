@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "GameServer.h"
+
+using namespace Hexxagon;
+
+/// Headless server of network games: pairs clients in order of
+/// joining and checks every step, or plays against them with
+/// a shared pool of search threads.
+///
+///   hexxagon_server [--port N] [--loopback] [--ai-workers N] [--ai-queue N]
+///                   [--ai-move MS] [--ai-budget MS] [--ai-level N] [--ai-book PATH]
+///
+/// '--ai-workers 0' turns games against computer off. '--ai-level'
+/// is the difficulty of clients, which don't ask for one: 0 - beginner
+/// to 4 - expert. '--ai-book' is the opening book of the levels,
+/// which play one, "Assets\book.bin" by default.
+///
+int main(int argc, char* argv[]) {
+	std::uint16_t port = 7777;
+	bool loopback = false;
+	AiScheduler::Options ai;
+	ai.workers = std::max(1u, std::thread::hardware_concurrency());
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg == "--port" && i + 1 < argc) port = (std::uint16_t)std::stoi(argv[++i]);
+		else if (arg == "--loopback") loopback = true;
+		else if (arg == "--ai-workers" && i + 1 < argc) ai.workers = std::stoi(argv[++i]);
+		else if (arg == "--ai-queue" && i + 1 < argc) ai.queue_limit = std::stoi(argv[++i]);
+		else if (arg == "--ai-move" && i + 1 < argc) ai.move_milliseconds = std::stoi(argv[++i]);
+		else if (arg == "--ai-budget" && i + 1 < argc) ai.budget_milliseconds = std::stoi(argv[++i]);
+		else if (arg == "--ai-level" && i + 1 < argc) ai.difficulty = std::clamp(std::stoi(argv[++i]), 0, (int)Difficulties.size() - 1);
+		else if (arg == "--ai-book" && i + 1 < argc) ai.book_path = argv[++i];
+		else {
+			std::cout << "Unknown option " << arg << "\n";
+			return 1;
+		}
+	}
+
+	if (!GameServer::Supported) {
+		std::cout << "Network games are not supported on this platform\n";
+		return 1;
+	}
+	GameServer server;
+	if (!server.start(port, loopback)) {
+		std::cout << "Could not listen on port " << port << "\n";
+		return 1;
+	}
+	if (ai.workers > 0)
+		server.enableAi(ai);
+	std::cout << "Listening on port " << server.getPort() << ", " << ai.workers << " search threads\n";
+	server.run();
+	return 0;
+}
@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Evaluation.h"
+#include "MappedFile.h"
+#include "TrainingData.h"
+
+using namespace Hexxagon;
+
+/// Fits evaluation weights to game results of training shards
+/// (Texel method): minimises squared error between the result
+/// and sigmoid of the evaluation, by gradient descent.
+///
+struct Options {
+	int iterations = 500;
+	double rate = 1.0;			// Adam step size, in weight units
+	int threads = std::max(1u, std::thread::hardware_concurrency());
+	std::string in_weights;			// starting weights, defaults of EvalWeights if empty
+	std::string out = "Assets\\weights.txt";
+	std::vector<std::string> shards;
+};
+
+/// Extracted features of all positions, stored by feature,
+/// so error of a batch is computed with plain loops over arrays.
+///
+struct Dataset {
+	std::vector<float> features[FeatureCount];
+	std::vector<float> results;		// 1 won, 0.5 draw, 0 lost, for the side to move
+
+	std::size_t size() const { return results.size(); }
+};
+
+constexpr std::size_t Batch = 1024;
+
+/// Predicted result of the evaluation: 1 / (1 + 10^(-k * eval / 400)).
+///
+static void predict(const Dataset& data, std::size_t first, std::size_t count, const double* weights, double k, float* out) {
+	for (std::size_t i = 0; i < count; i++)
+		out[i] = 0;
+	for (int f = 0; f < FeatureCount; f++) {
+		const float weight = (float)weights[f];
+		const float* feature = data.features[f].data() + first;
+		for (std::size_t i = 0; i < count; i++)
+			out[i] += weight * feature[i];
+	}
+	const float scale = (float)(-k * std::log(10.0) / 400);
+	for (std::size_t i = 0; i < count; i++)
+		out[i] = 1.f / (1.f + std::exp(scale * out[i]));
+}
+
+/// Returns mean squared error and, if 'gradient' is set,
+/// it's gradient by weights. Positions are split between threads.
+///
+static double computeError(const Dataset& data, const double* weights, double k, int threads, double* gradient) {
+	std::vector<double> errors(threads, 0);
+	std::vector<std::array<double, FeatureCount>> gradients(threads);
+	std::vector<std::thread> workers;
+	const std::size_t part = (data.size() + threads - 1) / threads;
+
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&, t] {
+			float predicted[Batch];
+			float delta[Batch];
+			gradients[t].fill(0);
+			const std::size_t end = std::min(data.size(), (t + 1) * part);
+			for (std::size_t first = t * part; first < end; first += Batch) {
+				const std::size_t count = std::min(Batch, end - first);
+				predict(data, first, count, weights, k, predicted);
+
+				const float* results = data.results.data() + first;
+				double error = 0;
+				for (std::size_t i = 0; i < count; i++) {
+					float difference = predicted[i] - results[i];
+					error += difference * difference;
+					delta[i] = difference * predicted[i] * (1 - predicted[i]);
+				}
+				errors[t] += error;
+
+				if (gradient != nullptr)
+					for (int f = 0; f < FeatureCount; f++) {
+						const float* feature = data.features[f].data() + first;
+						float sum = 0;
+						for (std::size_t i = 0; i < count; i++)
+							sum += delta[i] * feature[i];
+						gradients[t][f] += sum;
+					}
+			}
+		});
+	}
+	for (std::thread& worker : workers)
+		worker.join();
+
+	double error = 0;
+	for (int t = 0; t < threads; t++)
+		error += errors[t];
+	if (gradient != nullptr) {
+		const double factor = 2 * k * std::log(10.0) / 400 / data.size();
+		for (int f = 0; f < FeatureCount; f++) {
+			gradient[f] = 0;
+			for (int t = 0; t < threads; t++)
+				gradient[f] += gradients[t][f];
+			gradient[f] *= factor;
+		}
+	}
+	return error / data.size();
+}
+
+static bool loadShards(const Options& options, Dataset& data) {
+	std::vector<std::unique_ptr<MappedFile>> files;
+	std::size_t total = 0;
+	for (const std::string& path : options.shards) {
+		auto file = std::make_unique<MappedFile>(path);
+		if (!file->isOpen() || !TrainingShard::checkHeader(file->getData(), file->getSize())) {
+			std::cout << "Shard " << path << " could not be read\n";
+			return false;
+		}
+		total += (file->getSize() - TrainingShard::HeaderSize) / TrainingRecord::Size;
+		files.push_back(std::move(file));
+	}
+
+	for (auto& feature : data.features)
+		feature.resize(total);
+	data.results.resize(total);
+
+	/////////////////////////////////////////////////////////
+	/// Features are extracted in parallel, each thread
+	/// fills own range of the arrays
+	/////////////////////////////////////////////////////////
+	std::size_t offset = 0;
+	for (const auto& file : files) {
+		const std::size_t count = (file->getSize() - TrainingShard::HeaderSize) / TrainingRecord::Size;
+		const char* records = file->getData() + TrainingShard::HeaderSize;
+		const std::size_t part = (count + options.threads - 1) / options.threads;
+
+		std::vector<std::thread> workers;
+		for (int t = 0; t < options.threads; t++) {
+			workers.emplace_back([&, t] {
+				Features features;
+				for (std::size_t i = t * part; i < std::min(count, (t + 1) * part); i++) {
+					TrainingRecord record = TrainingRecord::read(records + i * TrainingRecord::Size);
+					extractFeatures(record.toPosition(), features);
+					for (int f = 0; f < FeatureCount; f++)
+						data.features[f][offset + i] = (float)features[f];
+					data.results[offset + i] = (record.result + 1) / 2.f;
+				}
+			});
+		}
+		for (std::thread& worker : workers)
+			worker.join();
+		offset += count;
+	}
+	return true;
+}
+
+int main(int argc, char* argv[]) {
+	Options options;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (!arg.starts_with("--"))
+			options.shards.push_back(arg);
+		else if (i + 1 == argc) {
+			std::cout << "Option " << arg << " has no value\n";
+			return 1;
+		}
+		else if (arg == "--iterations") options.iterations = std::stoi(argv[++i]);
+		else if (arg == "--rate") options.rate = std::stod(argv[++i]);
+		else if (arg == "--threads") options.threads = std::stoi(argv[++i]);
+		else if (arg == "--weights") options.in_weights = argv[++i];
+		else if (arg == "--out") options.out = argv[++i];
+		else {
+			std::cout << "Unknown option " << arg << "\n";
+			return 1;
+		}
+	}
+
+	EvalWeights start;
+	if (!options.in_weights.empty() && !start.load(options.in_weights)) {
+		std::cout << "Weights " << options.in_weights << " could not be read\n";
+		return 1;
+	}
+
+	Dataset data;
+	if (options.shards.empty() || !loadShards(options, data) || data.size() == 0) {
+		std::cout << "Usage: hexxagon_tune [options] shard...\n";
+		return 1;
+	}
+	std::cout << "Loaded " << data.size() << " positions\n";
+
+	double weights[FeatureCount];
+	for (int f = 0; f < FeatureCount; f++)
+		weights[f] = start.weights[f];
+
+	/////////////////////////////////////////////////////////
+	/// Scale of the sigmoid is fitted first, to the
+	/// starting weights, and kept through the tuning
+	/////////////////////////////////////////////////////////
+	double k = 1, best_error = computeError(data, weights, k, options.threads, nullptr);
+	for (double step = 0.5; step > 0.001; step /= 2) {
+		for (double candidate : { k - step, k + step }) {
+			double error = candidate > 0 ? computeError(data, weights, candidate, options.threads, nullptr) : best_error;
+			if (error < best_error) {
+				best_error = error;
+				k = candidate;
+			}
+		}
+	}
+	std::cout << "K = " << k << ", error " << best_error << "\n";
+
+	/////////////////////////////////////////////////////////
+	/// Adam optimiser over the full dataset
+	/////////////////////////////////////////////////////////
+	double gradient[FeatureCount], m[FeatureCount] = {}, v[FeatureCount] = {};
+	const double beta1 = 0.9, beta2 = 0.999;
+	for (int iteration = 1; iteration <= options.iterations; iteration++) {
+		double error = computeError(data, weights, k, options.threads, gradient);
+		for (int f = 0; f < FeatureCount; f++) {
+			m[f] = beta1 * m[f] + (1 - beta1) * gradient[f];
+			v[f] = beta2 * v[f] + (1 - beta2) * gradient[f] * gradient[f];
+			double m_hat = m[f] / (1 - std::pow(beta1, iteration));
+			double v_hat = v[f] / (1 - std::pow(beta2, iteration));
+			weights[f] -= options.rate * m_hat / (std::sqrt(v_hat) + 1e-12);
+		}
+		if (iteration % 50 == 0 || iteration == options.iterations)
+			std::cout << "Iteration " << iteration << ": error " << error << "\n";
+	}
+
+	EvalWeights tuned;
+	for (int f = 0; f < FeatureCount; f++) {
+		tuned.weights[f] = (int)std::lround(weights[f]);
+		std::cout << FeatureNames[f] << " " << tuned.weights[f] << "\n";
+	}
+	if (!tuned.save(options.out)) {
+		std::cout << "Weights could not be written to " << options.out << "\n";
+		return 1;
+	}
+	return 0;
+}